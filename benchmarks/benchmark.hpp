@@ -0,0 +1,137 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef BENCHMARKS_BENCHMARK_HPP
+#define BENCHMARKS_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Result
+{
+  std::string name;
+  size_t iterations;
+  double seconds;
+
+  double
+  nsPerOp() const
+  {
+    return iterations == 0 ? 0 : seconds * 1e9 / iterations;
+  }
+
+  double
+  opsPerSecond() const
+  {
+    return seconds == 0 ? 0 : iterations / seconds;
+  }
+};
+
+inline double
+secondsSince(Clock::time_point start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Every reported result, in order, for writeJson()
+inline std::vector<Result>&
+results()
+{
+  static std::vector<Result> all;
+  return all;
+}
+
+inline void
+report(const Result& result)
+{
+  results().push_back(result);
+
+  std::printf("%-48s %12zu iters %14.1f ns/op %14.0f ops/s\n",
+              result.name.c_str(), result.iterations, result.nsPerOp(), result.opsPerSecond());
+}
+
+// Calls fn(i) for i in [0, iterations) after a short warm up and reports the
+// average time per call
+template <typename Function>
+Result
+run(const std::string& name, size_t iterations, Function fn)
+{
+  for (size_t i = 0; i < iterations / 10; ++i) {
+    fn(i);
+  }
+
+  Clock::time_point start = Clock::now();
+
+  for (size_t i = 0; i < iterations; ++i) {
+    fn(i);
+  }
+
+  Result result = { name, iterations, secondsSince(start) };
+  report(result);
+
+  return result;
+}
+
+// Writes every reported result as a JSON array so that runs can be compared
+// by scripts. Returns false if the file cannot be written.
+inline bool
+writeJson(const std::string& path)
+{
+  FILE* file = std::fopen(path.c_str(), "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  std::fprintf(file, "[\n");
+
+  for (size_t i = 0; i < results().size(); ++i) {
+    const Result& result = results()[i];
+
+    // Names are plain ASCII, only quotes and backslashes need escaping
+    std::string name;
+    for (char c : result.name) {
+      if (c == '"' || c == '\\') {
+        name += '\\';
+      }
+      name += c;
+    }
+
+    std::fprintf(file, "  { \"name\": \"%s\", \"iterations\": %zu, \"seconds\": %.9f, "
+                       "\"ns_per_op\": %.3f, \"ops_per_second\": %.3f }%s\n",
+                 name.c_str(), result.iterations, result.seconds, result.nsPerOp(), result.opsPerSecond(),
+                 i + 1 < results().size() ? "," : "");
+  }
+
+  std::fprintf(file, "]\n");
+
+  return std::fclose(file) == 0;
+}
+
+} // namespace benchmark
+
+#endif // BENCHMARKS_BENCHMARK_HPP
@@ -0,0 +1,105 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+// Registration and lookup cost of the command registry at 10, 1k and 100k
+// commands, compared with the std::map it replaced
+
+#include "benchmark.hpp"
+
+#include "../include/impl/command-registry.hpp"
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using sfmlConsole::CommandHandle;
+using sfmlConsole::impl::CommandRegistry;
+
+int
+main(int argc, char* argv[])
+{
+  const size_t counts[] = { 10, 1000, 100000 };
+  const size_t lookups = 1000000;
+  size_t checksum = 0;
+
+  CommandRegistry::Command command = [&checksum] (const sfmlConsole::ConsoleApi::CommandParameterViews& params) {
+    checksum += params.size();
+  };
+
+  for (size_t count : counts) {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < count; ++i) {
+      names.push_back("sv_command_" + std::to_string(i * 7919));
+    }
+
+    // Look names up in random order so the table is not walked sequentially
+    std::vector<size_t> order(lookups);
+    std::mt19937 rng(42);
+    for (size_t& index : order) {
+      index = rng() % count;
+    }
+
+    std::string suffix = "/" + std::to_string(count);
+    sfmlConsole::ConsoleApi::CommandParameterViews params;
+
+    CommandRegistry registry;
+    benchmark::Clock::time_point start = benchmark::Clock::now();
+    for (const std::string& name : names) {
+      registry.insert(name, command);
+    }
+    benchmark::report({ "registry/register" + suffix, count, benchmark::secondsSince(start) });
+
+    std::map<std::string, CommandRegistry::Command, std::less<>> map;
+    start = benchmark::Clock::now();
+    for (const std::string& name : names) {
+      map[name] = command;
+    }
+    benchmark::report({ "map/register" + suffix, count, benchmark::secondsSince(start) });
+
+    benchmark::run("registry/find" + suffix, lookups, [&] (size_t i) {
+      checksum += registry.find(names[order[i]]).getIndex();
+    });
+
+    benchmark::run("map/find" + suffix, lookups, [&] (size_t i) {
+      checksum += map.find(names[order[i]]) != map.end();
+    });
+
+    std::vector<CommandHandle> handles;
+    for (const std::string& name : names) {
+      handles.push_back(registry.find(name));
+    }
+
+    benchmark::run("registry/invoke by handle" + suffix, lookups, [&] (size_t i) {
+      (*registry.get(handles[order[i]]))(params);
+    });
+
+    benchmark::run("registry/invoke by name" + suffix, lookups, [&] (size_t i) {
+      (*registry.get(registry.find(names[order[i]])))(params);
+    });
+  }
+
+  std::printf("checksum %zu\n", checksum);
+
+  return 0;
+}
@@ -0,0 +1,90 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+// Per-keystroke cost of narrowing tab completion candidates with 100k
+// registered names
+
+#include "benchmark.hpp"
+
+#include "../include/impl/completion-trie.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using sfmlConsole::impl::CompletionTrie;
+
+int
+main(int argc, char* argv[])
+{
+  const char* prefixes[] = { "sv_", "cl_", "r_", "snd_", "net_", "ai_", "phys_", "ui_" };
+  const size_t count = 100000;
+
+  std::vector<std::string> names;
+  std::mt19937 rng(42);
+
+  for (size_t i = 0; i < count; ++i) {
+    names.push_back(prefixes[rng() % 8] + std::string("var_") + std::to_string(rng() % 1000000));
+  }
+
+  CompletionTrie trie;
+
+  benchmark::Clock::time_point start = benchmark::Clock::now();
+  for (const std::string& name : names) {
+    trie.insert(name);
+  }
+  benchmark::report({ "trie/insert/100000", count, benchmark::secondsSince(start) });
+
+  // Type each name one character at a time, narrowing from the previous node
+  size_t nKeystrokes = 0;
+  size_t checksum = 0;
+
+  start = benchmark::Clock::now();
+  for (size_t i = 0; i < count; ++i) {
+    CompletionTrie::Node node = CompletionTrie::ROOT;
+
+    for (char c : names[i]) {
+      node = trie.step(node, c);
+      checksum += trie.getCount(node);
+      nKeystrokes++;
+    }
+  }
+  benchmark::report({ "trie/keystroke/100000", nKeystrokes, benchmark::secondsSince(start) });
+
+  // Press Tab after typing the shared "sv_var_" part of many names
+  CompletionTrie::Node node = trie.find("sv_var_");
+  benchmark::run("trie/tab after \"sv_var_\"/100000", 100000, [&] (size_t) {
+    std::string completed;
+    checksum += trie.extendCommonPrefix(node, completed);
+  });
+
+  benchmark::run("trie/list 16 candidates/100000", 100000, [&] (size_t) {
+    std::vector<std::string> candidates;
+    trie.collect(node, 16, candidates);
+    checksum += candidates.size();
+  });
+
+  std::printf("checksum %zu\n", checksum);
+
+  return 0;
+}
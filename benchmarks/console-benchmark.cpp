@@ -0,0 +1,393 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+// Headless benchmark suite for the console core: print(), tokenize(),
+// enterInput(), keystroke handling in handleEvent(), update(), draw() and
+// whole frames in each state of the console and while scrolling.
+// No window is opened; draw() renders into an sf::RenderTexture, which only
+// needs an OpenGL context (a software one such as Mesa's llvmpipe under Xvfb
+// is enough), and is skipped with --no-render or if the texture cannot be
+// created. Results are also written as JSON for tracking regressions.
+//
+// Usage: console-benchmark [--no-render] [--json path]
+
+#include "benchmark.hpp"
+
+#include "../include/impl/console.hpp"
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Window/Event.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Exposes enterInput(), which is otherwise only reachable through Return
+class BenchmarkConsole : public sfmlConsole::impl::Console
+{
+public:
+  using Console::Console;
+  using Console::enterInput;
+};
+
+static sf::Event
+keyPressed(sf::Keyboard::Key code)
+{
+  sf::Event event;
+  event.type = sf::Event::KeyPressed;
+  event.key.code = code;
+  event.key.alt = false;
+  event.key.control = false;
+  event.key.shift = false;
+  event.key.system = false;
+
+  return event;
+}
+
+static sf::Event
+textEntered(char c)
+{
+  sf::Event event;
+  event.type = sf::Event::TextEntered;
+  event.text.unicode = c;
+
+  return event;
+}
+
+int
+main(int argc, char* argv[])
+{
+  bool isRendering = true;
+  std::string jsonPath = "console-benchmark.json";
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--no-render") == 0) {
+      isRendering = false;
+    }
+    else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+      jsonPath = argv[++i];
+    }
+    else {
+      std::fprintf(stderr, "Usage: %s [--no-render] [--json path]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  sf::Font font;
+  if (!font.loadFromFile("fonts/SourceCodePro-Regular.otf")) {
+    std::fprintf(stderr, "Run from the repository root so that fonts/ can be found\n");
+    return 1;
+  }
+
+  const sf::Vector2u windowSize(1280, 720);
+  const std::string line = "The quick brown fox jumps over the lazy dog";
+
+  // Printing a line again right after itself only counts up on it, so
+  // benchmarks that add lines alternate between two
+  const std::string lines[] = { line, "Pack my box with five dozen liquor jugs" };
+
+  BenchmarkConsole console(windowSize, font);
+  console.registerCommand("say", [] (const sfmlConsole::ConsoleApi::CommandParameterViews&) {});
+  console.registerIntCvar("sv_value", 0);
+
+  // Open the console fully and fill the scrollback
+  console.show();
+  for (int i = 0; i < 1000; ++i) {
+    console.update();
+  }
+  for (size_t i = 0; i < sfmlConsole::Style::DEFAULT_SCROLLBACK_SIZE; ++i) {
+    console.print(lines[i % 2]);
+  }
+
+  // print()
+  benchmark::run("print/owner thread", 1000000, [&] (size_t i) {
+    console.print(lines[i % 2]);
+  });
+
+  // Escapes are parsed into spans once, when printed
+  const std::string coloredLine = "\033[32m[ok]\033[0m The quick brown fox \033[1;31mjumps\033[0m over the lazy dog";
+
+  benchmark::run("print/owner thread, colored", 1000000, [&] (size_t) {
+    console.print(coloredLine);
+  });
+
+  // A message printed again only counts up on its line, and a source over
+  // its rate limit only has its lines counted
+  benchmark::run("print/owner thread, repeated", 1000000, [&] (size_t) {
+    console.print("warning: texture not found, using the fallback");
+  });
+
+  console.setRateLimit("physics", 60, 10);
+
+  benchmark::run("print/owner thread, over rate limit", 1000000, [&] (size_t) {
+    console.print("physics", line);
+  });
+
+  // tokenize()
+  sfmlConsole::impl::Tokenizer tokenizer;
+  const std::string inputs[] = {
+    "say hello",
+    "bind mouse1 \"+attack; say \\\"fire in the hole\\\"\" 'literal \\ text'",
+    "spawn enemy_grunt 1024.5 -96.25 3 angle=90 team=red squad=alpha patrol=true",
+  };
+  size_t nTokens = 0;
+
+  benchmark::run("tokenize/mixed input", 1000000, [&] (size_t i) {
+    nTokens += tokenizer.tokenize(inputs[i % 3]).size();
+  });
+
+  // enterInput()
+  benchmark::run("enterInput/command", 200000, [&] (size_t) {
+    console.insert("say \"hello world\" 42");
+    console.enterInput();
+  });
+
+  benchmark::run("enterInput/cvar", 200000, [&] (size_t) {
+    console.insert("sv_value 42");
+    console.enterInput();
+  });
+
+  benchmark::run("enterInput/unknown command", 200000, [&] (size_t) {
+    console.insert("no_such_command 42");
+    console.enterInput();
+  });
+
+  // handleEvent(), typing and deleting so the input does not keep growing
+  const sf::Event backspace = keyPressed(sf::Keyboard::BackSpace);
+  const sf::Event left = keyPressed(sf::Keyboard::Left);
+  const sf::Event right = keyPressed(sf::Keyboard::Right);
+  sf::Event wordLeft = keyPressed(sf::Keyboard::Left);
+  sf::Event wordRight = keyPressed(sf::Keyboard::Right);
+  wordLeft.key.control = true;
+  wordRight.key.control = true;
+
+  benchmark::run("handleEvent/type+backspace", 1000000, [&] (size_t i) {
+    console.handleEvent(textEntered(static_cast<char>('a' + i % 26)));
+    console.handleEvent(backspace);
+  });
+
+  console.insert(line);
+
+  benchmark::run("handleEvent/cursor left+right", 1000000, [&] (size_t) {
+    console.handleEvent(left);
+    console.handleEvent(right);
+  });
+
+  // Editing in the middle of a very long pasted command costs the same
+  std::string longInput = "say";
+  while (longInput.size() < 100000) {
+    longInput += " argument";
+  }
+
+  console.insert(longInput);
+  for (int i = 0; i < 50000; ++i) {
+    console.handleEvent(left);
+  }
+
+  benchmark::run("handleEvent/type+backspace, 100k input", 1000000, [&] (size_t i) {
+    console.handleEvent(textEntered(static_cast<char>('a' + i % 26)));
+    console.handleEvent(backspace);
+  });
+
+  benchmark::run("handleEvent/word left+right, 100k input", 1000000, [&] (size_t) {
+    console.handleEvent(wordLeft);
+    console.handleEvent(wordRight);
+  });
+
+  // Clears the input
+  console.enterInput();
+
+  // update()
+  benchmark::run("update/open idle", 1000000, [&] (size_t) {
+    console.update();
+  });
+
+  benchmark::run("update/open+print", 1000000, [&] (size_t i) {
+    console.print(lines[i % 2]);
+    console.update();
+  });
+
+  BenchmarkConsole closed(windowSize, font);
+
+  benchmark::run("update/closed idle", 1000000, [&] (size_t) {
+    closed.update();
+  });
+
+  benchmark::run("update/closed+print", 1000000, [&] (size_t i) {
+    closed.print(lines[i % 2]);
+    closed.update();
+  });
+
+  // draw()
+  sf::RenderTexture target;
+
+  if (!isRendering) {
+    std::printf("Skipping draw(), rendering is disabled\n");
+  }
+  else if (!target.create(windowSize.x, windowSize.y)) {
+    std::printf("Skipping draw(), no OpenGL context is available\n");
+  }
+  else {
+    benchmark::run("draw/unchanged", 5000, [&] (size_t) {
+      target.clear();
+      target.draw(console);
+      target.display();
+    });
+
+    benchmark::run("draw/print every frame", 5000, [&] (size_t i) {
+      console.print(lines[i % 2]);
+      target.clear();
+      target.draw(console);
+      target.display();
+    });
+
+    // The same frames laid out glyph by glyph with kerning, as for a
+    // proportional font, rather than one advance apart
+    sfmlConsole::Style proportionalStyle = sfmlConsole::Style::Default;
+    proportionalStyle.setFontSpacing(sfmlConsole::Style::FontSpacing::PROPORTIONAL);
+
+    BenchmarkConsole proportional(windowSize, font, proportionalStyle);
+    proportional.show();
+    for (int i = 0; i < 1000; ++i) {
+      proportional.update();
+    }
+    for (size_t i = 0; i < sfmlConsole::Style::DEFAULT_SCROLLBACK_SIZE; ++i) {
+      proportional.print(lines[i % 2]);
+    }
+
+    benchmark::run("draw/print every frame, proportional layout", 5000, [&] (size_t i) {
+      proportional.print(lines[i % 2]);
+      target.clear();
+      target.draw(proportional);
+      target.display();
+    });
+
+    // Every span of every line is still one draw call
+    benchmark::run("draw/print colored every frame", 5000, [&] (size_t) {
+      console.print(coloredLine);
+      target.clear();
+      target.draw(console);
+      target.display();
+    });
+
+    benchmark::run("draw/typing every frame", 5000, [&] (size_t i) {
+      console.handleEvent(textEntered(static_cast<char>('a' + i % 26)));
+      console.handleEvent(backspace);
+      target.clear();
+      target.draw(console);
+      target.display();
+    });
+
+    // A whole frame, update() and draw(), in each state. The empty frame is
+    // the cost of clear() and display() alone.
+    benchmark::run("frame/empty", 100000, [&] (size_t) {
+      target.clear();
+      target.display();
+    });
+
+    benchmark::run("frame/closed", 100000, [&] (size_t) {
+      closed.update();
+      target.clear();
+      target.draw(closed);
+      target.display();
+    });
+
+    benchmark::run("frame/closed+print", 100000, [&] (size_t i) {
+      closed.print(lines[i % 2]);
+      closed.update();
+      target.clear();
+      target.draw(closed);
+      target.display();
+    });
+
+    benchmark::run("frame/open", 5000, [&] (size_t) {
+      console.update();
+      target.clear();
+      target.draw(console);
+      target.display();
+    });
+
+    // Smooth scrolling, turning the wheel every 20 frames and alternating
+    // direction. A full scrollback costs the same as a short one.
+    sf::Event wheelUp;
+    wheelUp.type = sf::Event::MouseWheelScrolled;
+    wheelUp.mouseWheelScroll.wheel = sf::Mouse::VerticalWheel;
+    wheelUp.mouseWheelScroll.delta = 1;
+    wheelUp.mouseWheelScroll.x = 0;
+    wheelUp.mouseWheelScroll.y = 0;
+
+    sf::Event wheelDown = wheelUp;
+    wheelDown.mouseWheelScroll.delta = -1;
+
+    BenchmarkConsole shortOutput(windowSize, font);
+    shortOutput.show();
+    for (int i = 0; i < 1000; ++i) {
+      shortOutput.update();
+    }
+    for (int i = 0; i < 100; ++i) {
+      shortOutput.print(lines[i % 2]);
+    }
+
+    for (BenchmarkConsole* scrolled : { &shortOutput, &console }) {
+      std::string name = scrolled == &console ? "frame/wheel scroll, full scrollback" : "frame/wheel scroll, 100 lines";
+
+      benchmark::run(name, 5000, [&] (size_t i) {
+        if (i % 20 == 0) {
+          scrolled->handleEvent(i % 40 == 0 ? wheelUp : wheelDown);
+        }
+        scrolled->update();
+        target.clear();
+        target.draw(*scrolled);
+        target.display();
+      });
+    }
+
+    // Turning around every other frame keeps the console sliding, between
+    // OPENING and CLOSING, without ever reaching either end
+    BenchmarkConsole sliding(windowSize, font);
+    sliding.show();
+    for (int i = 0; i < 4; ++i) {
+      sliding.update();
+    }
+
+    benchmark::run("frame/opening+closing", 5000, [&] (size_t i) {
+      if (i % 2 == 0) {
+        sliding.toggle();
+      }
+      sliding.update();
+      target.clear();
+      target.draw(sliding);
+      target.display();
+    });
+  }
+
+  if (!benchmark::writeJson(jsonPath)) {
+    std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+    return 1;
+  }
+
+  std::printf("Results written to %s (%zu tokens)\n", jsonPath.c_str(), nTokens);
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+// Measures Console::draw() against the number of visible output lines, for
+// an unchanged console, for one that has new output every frame, and for
+// wrapped output whose width changes every frame
+
+#include "benchmark.hpp"
+
+#include "../include/impl/console.hpp"
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Window/Event.hpp>
+
+#include <string>
+
+int
+main(int argc, char* argv[])
+{
+  sf::Font font;
+  font.loadFromFile("fonts/SourceCodePro-Regular.otf");
+
+  const sfmlConsole::Style& style = sfmlConsole::Style::Default;
+  const size_t frames = 2000;
+  const size_t lineCounts[] = { 10, 25, 50, 100, 200 };
+
+  for (size_t visibleLines : lineCounts) {
+    // Size the console so that exactly visibleLines lines of history fit
+    unsigned int height = static_cast<unsigned int>(
+      ((visibleLines + 2) * style.getFontSize() + 2 * style.getMarginSize()) / style.getHeightPercentage());
+
+    sf::Vector2u size(1280, height);
+    sfmlConsole::impl::Console console(size, font, style);
+
+    console.show();
+
+    for (size_t i = 0; i < visibleLines * 2; ++i) {
+      console.print("The quick brown fox jumps over the lazy dog " + std::to_string(i));
+    }
+
+    sf::RenderTexture target;
+    target.create(size.x, size.y);
+
+    benchmark::run("draw/" + std::to_string(visibleLines) + " lines", frames, [&] (size_t) {
+      target.clear();
+      target.draw(console);
+      target.display();
+    });
+
+    benchmark::run("draw+print/" + std::to_string(visibleLines) + " lines", frames, [&] (size_t i) {
+      console.print("The quick brown fox jumps over the lazy dog " + std::to_string(i));
+      target.clear();
+      target.draw(console);
+      target.display();
+    });
+
+    // Lines wrapping to about three rows, wrapped again for a new width
+    // every frame
+    std::string longLine;
+    while (longLine.size() < 300) {
+      longLine += "The quick brown fox jumps over the lazy dog ";
+    }
+
+    for (size_t i = 0; i < visibleLines; ++i) {
+      console.print(longLine + std::to_string(i));
+    }
+
+    benchmark::run("draw+resize/" + std::to_string(visibleLines) + " lines", frames, [&] (size_t i) {
+      sf::Event event;
+      event.type = sf::Event::Resized;
+      event.size.width = size.x - (i % 2) * 100;
+      event.size.height = size.y;
+
+      console.handleEvent(event);
+      target.clear();
+      target.draw(console);
+      target.display();
+    });
+  }
+
+  return 0;
+}
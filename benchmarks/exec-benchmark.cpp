@@ -0,0 +1,105 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+// Executes a generated script of a million lines through the exec command and
+// reports the commands executed per second, along with the worst update()
+// so that the per-frame line budget can be checked
+
+#include "benchmark.hpp"
+
+#include "../include/impl/console.hpp"
+
+#include <SFML/Graphics/Font.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+int
+main(int argc, char* argv[])
+{
+  const size_t lines = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  const std::string path = "exec-benchmark.cfg";
+
+  // Mix of commands, cvar assignments, comments and quoted parameters
+  FILE* file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    std::fprintf(stderr, "Cannot write %s\n", path.c_str());
+    return 1;
+  }
+
+  for (size_t i = 0; i < lines; ++i) {
+    switch (i % 4) {
+    case 0:
+      std::fprintf(file, "count %zu\n", i);
+      break;
+    case 1:
+      std::fprintf(file, "count \"quoted parameter\" %zu two three\n", i);
+      break;
+    case 2:
+      std::fprintf(file, "sv_value %zu\n", i);
+      break;
+    default:
+      std::fprintf(file, "# comment %zu\n", i);
+      break;
+    }
+  }
+
+  std::fclose(file);
+
+  sf::Font font;
+  font.loadFromFile("fonts/SourceCodePro-Regular.otf");
+
+  sfmlConsole::impl::Console console(sf::Vector2u(640, 480), font, sfmlConsole::Style::Default);
+
+  size_t executed = 0;
+  console.registerCommand("count", [&executed] (const sfmlConsole::ConsoleApi::CommandParameterViews&) {
+    executed++;
+  });
+  console.registerIntCvar("sv_value", 0);
+
+  benchmark::Clock::time_point start = benchmark::Clock::now();
+  console.exec(path);
+
+  size_t frames = 0;
+  double worstFrame = 0;
+
+  while (executed < lines / 2) {
+    benchmark::Clock::time_point frameStart = benchmark::Clock::now();
+    console.update();
+    worstFrame = std::max(worstFrame, benchmark::secondsSince(frameStart));
+    frames++;
+  }
+
+  // Comments are skipped by the reader, so only three in four lines count
+  benchmark::Result result = { "exec/" + std::to_string(lines) + " lines", lines - lines / 4,
+                               benchmark::secondsSince(start) };
+  benchmark::report(result);
+
+  std::printf("%zu frames, worst update() %.3f ms\n", frames, worstFrame * 1e3);
+
+  std::remove(path.c_str());
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+// Startup cost of the persistent input history: how long loading a history
+// file of 100k entries takes, compared with reading the same entries from a
+// text file one line at a time.
+//
+// Usage: history-benchmark [entries]
+
+#include "benchmark.hpp"
+
+#include "../include/impl/input-history.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+int
+main(int argc, char* argv[])
+{
+  const size_t entries = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  const std::string path = "history-benchmark.bin";
+  const std::string textPath = "history-benchmark.txt";
+
+  std::remove(path.c_str());
+
+  {
+    sfmlConsole::impl::InputHistory history;
+    history.open(path, entries);
+
+    std::ofstream text(textPath);
+
+    for (size_t i = 0; i < entries; ++i) {
+      std::string entry = "spawn enemy_grunt " + std::to_string(i % 977) + " " + std::to_string(i) + " team=red";
+      history.push(entry);
+      text << entry << '\n';
+    }
+  }
+
+  size_t checksum = 0;
+
+  benchmark::Result load = benchmark::run("history/load " + std::to_string(entries), 50, [&] (size_t) {
+    sfmlConsole::impl::InputHistory history;
+    history.open(path, entries);
+    checksum += history.size();
+  });
+
+  benchmark::run("history/text getline baseline", 50, [&] (size_t) {
+    std::ifstream text(textPath);
+    std::vector<std::string> lines;
+    std::string line;
+
+    while (std::getline(text, line)) {
+      lines.push_back(line);
+    }
+
+    checksum += lines.size();
+  });
+
+  // Loading a file over its limit also starts a compaction
+  benchmark::run("history/load over capacity", 50, [&] (size_t) {
+    sfmlConsole::impl::InputHistory history;
+    history.open(path, entries / 4);
+    checksum += history.size();
+  });
+
+  std::printf("startup: %.2f ms for %zu entries (checksum %zu)\n", load.nsPerOp() / 1e6, entries, checksum);
+
+  std::remove(path.c_str());
+  std::remove(textPath.c_str());
+
+  return 0;
+}
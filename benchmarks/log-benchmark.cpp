@@ -0,0 +1,97 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+// Cost that mirroring output to a log file adds to Console::print(), and the
+// sustained number of lines per second the log writer gets to disk.
+//
+// Usage: log-benchmark [lines]
+
+#include "benchmark.hpp"
+
+#include "../include/impl/console.hpp"
+#include "../include/impl/log-sink.hpp"
+
+#include <SFML/Graphics/Font.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+static void
+removeLogs(const std::string& path)
+{
+  std::remove(path.c_str());
+  std::remove((path + ".1").c_str());
+}
+
+int
+main(int argc, char* argv[])
+{
+  const size_t lines = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+  const std::string path = "log-benchmark.log";
+  const std::string line = "[server] client 192.168.0.42 connected, 12 players on de_dust2";
+
+  // Printing a line again right after itself only counts up on it
+  const std::string messages[] = { line, "[server] client 192.168.0.17 disconnected, 11 players on de_dust2" };
+
+  sf::Font font;
+  font.loadFromFile("fonts/SourceCodePro-Regular.otf");
+
+  sfmlConsole::impl::Console console(sf::Vector2u(1280, 720), font);
+
+  benchmark::Result withoutLog = benchmark::run("print/no log", lines, [&] (size_t i) {
+    console.print(messages[i % 2]);
+  });
+
+  removeLogs(path);
+  console.openLog(path, 256 * 1024 * 1024, 1);
+
+  benchmark::Result withLog = benchmark::run("print/log", lines, [&] (size_t i) {
+    console.print(messages[i % 2]);
+  });
+
+  console.closeLog();
+
+  std::printf("log adds %.1f ns per print()\n", withLog.nsPerOp() - withoutLog.nsPerOp());
+
+  // Sustained rate, including writing out everything still pending when the
+  // sink is destroyed
+  removeLogs(path);
+
+  benchmark::Clock::time_point start = benchmark::Clock::now();
+  {
+    sfmlConsole::impl::LogSink sink(path, 256 * 1024 * 1024, 1);
+    for (size_t i = 0; i < lines; ++i) {
+      sink.write(line);
+    }
+  }
+
+  benchmark::Result sustained = { "log sink/sustained", lines, benchmark::secondsSince(start) };
+  benchmark::report(sustained);
+
+  std::printf("%.1f MB/s\n", sustained.opsPerSecond() * (line.size() + 1) / (1024 * 1024));
+
+  removeLogs(path);
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+// Stress test of the cross-thread print path. N producer threads push
+// millions of lines into a PrintQueue while the main thread drains it into a
+// Scrollback once per simulated frame, the same way Console::update() does.
+//
+// Usage: print-stress-benchmark [threads] [lines per thread] [frame us]
+
+#include "benchmark.hpp"
+
+#include "../include/impl/print-queue.hpp"
+#include "../include/impl/scrollback.hpp"
+#include "../include/style.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+int
+main(int argc, char* argv[])
+{
+  size_t nThreads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+  size_t nLines = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+  long frameMicroseconds = argc > 3 ? std::strtol(argv[3], nullptr, 10) : 1000;
+
+  sfmlConsole::impl::PrintQueue queue(4096);
+  sfmlConsole::impl::Scrollback scrollback(sfmlConsole::Style::DEFAULT_SCROLLBACK_SIZE);
+
+  std::atomic<size_t> nRunning(nThreads);
+  std::vector<std::thread> producers;
+  std::vector<double> pushSeconds(nThreads);
+
+  benchmark::Clock::time_point start = benchmark::Clock::now();
+
+  for (size_t t = 0; t < nThreads; ++t) {
+    producers.emplace_back([&, t] {
+      std::string line = "[worker " + std::to_string(t) + "] job finished in 0.42 ms";
+
+      benchmark::Clock::time_point threadStart = benchmark::Clock::now();
+      for (size_t i = 0; i < nLines; ++i) {
+        queue.push(line);
+      }
+      pushSeconds[t] = benchmark::secondsSince(threadStart);
+
+      nRunning--;
+    });
+  }
+
+  size_t nAccepted = 0;
+  size_t nDropped = 0;
+  size_t nFrames = 0;
+  double maxDrainSeconds = 0;
+  double totalDrainSeconds = 0;
+
+  while (nRunning > 0 || !queue.empty()) {
+    benchmark::Clock::time_point frameStart = benchmark::Clock::now();
+
+    nAccepted += queue.drain([&] (const std::string& msg, const std::string&) {
+      scrollback.push(msg, sf::Color::White);
+    });
+    nDropped += queue.takeDropped();
+
+    double drainSeconds = benchmark::secondsSince(frameStart);
+    maxDrainSeconds = std::max(maxDrainSeconds, drainSeconds);
+    totalDrainSeconds += drainSeconds;
+    nFrames++;
+
+    if (frameMicroseconds > 0) {
+      std::this_thread::sleep_until(frameStart + std::chrono::microseconds(frameMicroseconds));
+    }
+  }
+
+  double seconds = benchmark::secondsSince(start);
+
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+
+  double maxPushSeconds = *std::max_element(pushSeconds.begin(), pushSeconds.end());
+  size_t nPushed = nThreads * nLines;
+
+  std::printf("threads                 %zu\n", nThreads);
+  std::printf("lines pushed            %zu\n", nPushed);
+  std::printf("lines accepted          %zu\n", nAccepted);
+  std::printf("lines dropped           %zu\n", nDropped);
+  std::printf("push throughput         %.0f lines/s\n", nPushed / maxPushSeconds);
+  std::printf("push cost               %.1f ns/line/thread\n", maxPushSeconds * 1e9 / nLines);
+  std::printf("drained throughput      %.0f lines/s\n", nAccepted / seconds);
+  std::printf("frames                  %zu\n", nFrames);
+  std::printf("mean drain per frame    %.1f us\n", totalDrainSeconds * 1e6 / nFrames);
+  std::printf("worst drain per frame   %.1f us\n", maxDrainSeconds * 1e6);
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+// Measures what the first frames of a console cost: constructing it, the
+// first frame after that, and the first frame after it is opened, with and
+// without rasterizing the printable characters in the constructor. Each run
+// loads the font again, since glyphs stay in the font once rasterized.
+// draw() needs an OpenGL context, as in console-benchmark.
+//
+// Usage: startup-benchmark [runs]
+
+#include "benchmark.hpp"
+
+#include "../include/impl/console.hpp"
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+int
+main(int argc, char* argv[])
+{
+  size_t nRuns = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20;
+
+  const sf::Vector2u windowSize(1280, 720);
+
+  // Enough to slide the console fully open
+  const size_t OPENING_FRAMES = 200;
+
+  sf::RenderTexture target;
+  if (!target.create(windowSize.x, windowSize.y)) {
+    std::fprintf(stderr, "No OpenGL context is available\n");
+    return 1;
+  }
+
+  for (bool isPrewarming : { false, true }) {
+    std::string suffix = isPrewarming ? ", prewarmed" : "";
+    benchmark::Result construction = { "startup/constructor" + suffix, nRuns, 0 };
+    benchmark::Result firstFrame = { "startup/constructor to first frame" + suffix, nRuns, 0 };
+    benchmark::Result firstOpenFrame = { "startup/first open frame" + suffix, nRuns, 0 };
+    benchmark::Result worstOpeningFrame = { "startup/worst frame while opening" + suffix, nRuns, 0 };
+
+    for (size_t run = 0; run < nRuns; ++run) {
+      sf::Font font;
+      if (!font.loadFromFile("fonts/SourceCodePro-Regular.otf")) {
+        std::fprintf(stderr, "Run from the repository root so that fonts/ can be found\n");
+        return 1;
+      }
+
+      sfmlConsole::Style style = sfmlConsole::Style::Default;
+      style.setPrewarmingGlyphs(isPrewarming);
+
+      benchmark::Clock::time_point start = benchmark::Clock::now();
+
+      sfmlConsole::impl::Console console(windowSize, font, style);
+      construction.seconds += benchmark::secondsSince(start);
+
+      console.print("Type 'help' for a list of commands");
+      console.update();
+      target.clear();
+      target.draw(console);
+      target.display();
+      firstFrame.seconds += benchmark::secondsSince(start);
+
+      // Opening shows the output for the first time. The slide takes many
+      // frames, and any of them may be the first to show a character.
+      console.show();
+
+      double worst = 0;
+      for (size_t frame = 0; frame < OPENING_FRAMES; ++frame) {
+        benchmark::Clock::time_point frameStart = benchmark::Clock::now();
+
+        console.update();
+        target.clear();
+        target.draw(console);
+        target.display();
+
+        double seconds = benchmark::secondsSince(frameStart);
+        worst = std::max(worst, seconds);
+
+        if (frame == 0) {
+          firstOpenFrame.seconds += seconds;
+        }
+      }
+
+      worstOpeningFrame.seconds += worst;
+    }
+
+    benchmark::report(construction);
+    benchmark::report(firstFrame);
+    benchmark::report(firstOpenFrame);
+    benchmark::report(worstOpeningFrame);
+  }
+
+  return 0;
+}
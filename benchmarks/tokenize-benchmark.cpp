@@ -0,0 +1,84 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+// Compares the hand-written Tokenizer with the std::regex based tokenize()
+// it replaced
+
+#include "benchmark.hpp"
+
+#include "../include/impl/tokenizer.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <regex>
+#include <string>
+#include <vector>
+
+// The previous implementation, which built a new std::regex on every call
+static std::vector<std::string>
+regexTokenize(const std::string& input)
+{
+  std::vector<std::string> tokens;
+
+  std::regex re("(\".*\")|(\'.*\')|([^\\s]?[^\\s]+)");
+
+  std::copy(std::sregex_token_iterator(input.begin(), input.end(), re),
+            std::sregex_token_iterator(),
+            std::back_inserter(tokens));
+
+  return tokens;
+}
+
+int
+main(int argc, char* argv[])
+{
+  const std::string inputs[] = {
+    "hello",
+    "set r_fullscreen 1",
+    "bind mouse1 \"+attack; say \\\"fire in the hole\\\"\" 'literal \\ text'",
+    "spawn enemy_grunt 1024.5 -96.25 3 angle=90 team=red squad=alpha patrol=true",
+  };
+
+  const size_t iterations = 200000;
+  size_t checksum = 0;
+
+  for (const std::string& input : inputs) {
+    std::string label = "\"" + input.substr(0, 24) + (input.size() > 24 ? "...\"" : "\"");
+
+    benchmark::Result regex = benchmark::run("regex/" + label, iterations / 10, [&] (size_t) {
+      checksum += regexTokenize(input).size();
+    });
+
+    sfmlConsole::impl::Tokenizer tokenizer;
+    benchmark::Result lexer = benchmark::run("lexer/" + label, iterations, [&] (size_t) {
+      checksum += tokenizer.tokenize(input).size();
+    });
+
+    std::printf("%-48s %12.1fx\n", "speedup", regex.nsPerOp() / lexer.nsPerOp());
+  }
+
+  // Keep the results observable so the work is not optimized away
+  std::printf("checksum %zu\n", checksum);
+
+  return 0;
+}
@@ -28,7 +28,10 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Window/Event.hpp>
 
-#include <exception>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
 
 int
 main(int argc, char* arv[])
@@ -51,24 +54,26 @@ main(int argc, char* arv[])
     }
   );
 
-  // Register command "set" which updates the value of variable using the
-  // first parameter
-  int variable = 0;
-  console.registerCommand(
-    "set",
-    [&console, &variable] (const SfmlConsole::CommandParameters& params) {
-      if (params.size() != 1) {
-        console.print("Expected 1 parameter; got " + std::to_string(params.size()));
-        return;
-      }
+  // Register cvar "variable", which can be set by entering "variable 42"
+  sfmlConsole::IntCvar* variable = console.registerIntCvar("variable", 0, "Value drawn in the window");
 
-      // Try to assign the first parameter to variable. If an error occurs,
-      // print the error
-      try {
-        variable = std::stoi(params.front());
-      }
-      catch (const std::exception& e) {
-        console.print("Error: " + std::string(e.what()));
+  // Print the new value whenever variable changes
+  variable->setChangeCallback(
+    [&console] (const sfmlConsole::CvarBase& cvar) {
+      console.print("variable changed to " + cvar.toString());
+    }
+  );
+
+  // Register command "count" which counts to its first parameter on a worker
+  // thread, one number per second, until it finishes or is cancelled
+  console.registerAsyncCommand(
+    "count",
+    [] (const SfmlConsole::CommandParameters& params, sfmlConsole::AsyncCommandContext& context) {
+      int n = params.empty() ? 10 : std::atoi(params.front().c_str());
+
+      for (int i = 1; i <= n && !context.isCancelled(); ++i) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        context.print(std::to_string(i));
       }
     }
   );
@@ -86,11 +91,15 @@ main(int argc, char* arv[])
         if (event.key.code == sf::Keyboard::Escape) {
           window.close();
         }
-        else if (event.key.code == sf::Keyboard::Tab) {
+        else if (event.key.code == sf::Keyboard::Tilde) {
           // Open or close the console
           console.toggle();
         }
       }
+      else if (event.type == sf::Event::TextEntered && event.text.unicode == '`') {
+        // Don't type the toggle key into the console
+        continue;
+      }
 
       // Pass SFML events to the console
       console.handleEvent(event);
@@ -102,7 +111,7 @@ main(int argc, char* arv[])
     window.clear(sf::Color::Black);
 
     // Draw variable's value
-    sf::Text text("Variable: " + std::to_string(variable), font);
+    sf::Text text("Variable: " + std::to_string(variable->get()), font);
     text.setPosition(sf::Vector2f(0, window.getSize().y/2));
     text.setColor(sf::Color::White);
 
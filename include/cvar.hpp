@@ -0,0 +1,210 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef SFML_CONSOLE_CVAR_HPP
+#define SFML_CONSOLE_CVAR_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace sfmlConsole {
+
+// A console variable that can be read from any thread and is set by typing
+// "name value" into the console.
+//
+// Cvars are created and owned by the console; keep the returned pointer to
+// read them without looking up their name.
+class CvarBase
+{
+public:
+  enum class Type {
+    INT = 0,
+    FLOAT,
+    BOOL,
+    STRING
+  };
+
+  typedef std::function<void(const CvarBase&)> ChangeCallback;
+
+  // Changes are collected into a lock-free list that the console drains in
+  // update(), where each changed cvar's callback is called once
+  typedef std::atomic<CvarBase*> PendingList;
+
+public:
+  virtual
+  ~CvarBase(){};
+
+  const std::string&
+  getName() const
+  {
+    return m_name;
+  }
+
+  const std::string&
+  getDescription() const
+  {
+    return m_description;
+  }
+
+  Type
+  getType() const
+  {
+    return m_type;
+  }
+
+  // Returns false if value cannot be parsed as the cvar's type
+  virtual bool
+  setFromString(std::string_view value) = 0;
+
+  virtual std::string
+  toString() const = 0;
+
+  // Called from the console's update() after the value changed. Several
+  // changes between two updates result in a single call.
+  void
+  setChangeCallback(const ChangeCallback& callback)
+  {
+    m_callback = callback;
+  }
+
+  // Console only. Clears the pending flag and returns the next changed cvar.
+  CvarBase*
+  takeNextPending();
+
+  void
+  notifyCallback() const;
+
+protected:
+  CvarBase(const std::string& name, const std::string& description, Type type, PendingList& pending);
+
+  // Safe to call from any thread
+  void
+  markChanged();
+
+private:
+  std::string m_name;
+  std::string m_description;
+  Type m_type;
+
+  ChangeCallback m_callback;
+
+  PendingList& m_pending;
+  CvarBase* m_nextPending;
+  std::atomic<bool> m_isPending;
+};
+
+// int, float and bool cvars hold their value in an atomic, so get() is a
+// single lock-free load
+template <typename T>
+class Cvar : public CvarBase
+{
+public:
+  Cvar(const std::string& name, const std::string& description, T value, PendingList& pending);
+
+  T
+  get() const
+  {
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+  operator T() const
+  {
+    return get();
+  }
+
+  // Safe to call from any thread
+  void
+  set(T value)
+  {
+    if (m_value.exchange(value, std::memory_order_relaxed) != value) {
+      markChanged();
+    }
+  }
+
+  virtual bool
+  setFromString(std::string_view value) override;
+
+  virtual std::string
+  toString() const override;
+
+private:
+  std::atomic<T> m_value;
+};
+
+// String cvars are stored in atomic words guarded by a sequence counter.
+// Readers copy the words and retry if a write happened meanwhile, so they
+// never take a lock; writers are serialized with a mutex. Values longer than
+// MAX_LENGTH are truncated.
+template <>
+class Cvar<std::string> : public CvarBase
+{
+public:
+  static const size_t MAX_LENGTH = 255;
+
+public:
+  Cvar(const std::string& name, const std::string& description, std::string_view value, PendingList& pending);
+
+  std::string
+  get() const;
+
+  operator std::string() const
+  {
+    return get();
+  }
+
+  // Safe to call from any thread
+  void
+  set(std::string_view value);
+
+  virtual bool
+  setFromString(std::string_view value) override;
+
+  virtual std::string
+  toString() const override;
+
+private:
+  // Returns false if the value was already stored
+  bool
+  store(std::string_view value);
+
+private:
+  static const size_t WORD_COUNT = (MAX_LENGTH + 1 + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  std::atomic<uint32_t> m_sequence;
+  std::atomic<uint64_t> m_words[WORD_COUNT];
+
+  std::mutex m_writeMutex;
+};
+
+typedef Cvar<int> IntCvar;
+typedef Cvar<float> FloatCvar;
+typedef Cvar<bool> BoolCvar;
+typedef Cvar<std::string> StringCvar;
+
+} // namespace sfmlConsole
+
+#endif // SFML_CONSOLE_CVAR_HPP
@@ -0,0 +1,101 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_ASYNC_JOB_HPP
+#define IMPL_ASYNC_JOB_HPP
+
+#include "../sfml-console.hpp"
+
+#include <atomic>
+#include <string>
+
+namespace sfmlConsole {
+namespace impl {
+
+// One invocation of an asynchronous command. The job is shared between the
+// worker that runs it and the console, which polls isFinished() in update().
+class AsyncJob : public AsyncCommandContext
+{
+public:
+  AsyncJob(ConsoleApi& console,
+           unsigned int id,
+           const std::string& name,
+           const ConsoleApi::CommandParameterViews& params,
+           const ConsoleApi::AsyncCommand& command);
+
+  // Worker thread only
+  void
+  run();
+
+  virtual void
+  print(const std::string& msg) override;
+
+  virtual bool
+  isCancelled() const override
+  {
+    return m_isCancelled.load(std::memory_order_relaxed);
+  }
+
+  void
+  cancel()
+  {
+    m_isCancelled.store(true, std::memory_order_relaxed);
+  }
+
+  bool
+  isFinished() const
+  {
+    return m_isFinished.load(std::memory_order_acquire);
+  }
+
+  unsigned int
+  getId() const
+  {
+    return m_id;
+  }
+
+  const std::string&
+  getName() const
+  {
+    return m_name;
+  }
+
+private:
+  ConsoleApi& m_console;
+
+  unsigned int m_id;
+  std::string m_name;
+
+  // The entered input is gone by the time the job runs, so the parameters
+  // are copied
+  ConsoleApi::CommandParameters m_params;
+  ConsoleApi::AsyncCommand m_command;
+
+  std::atomic<bool> m_isCancelled;
+  std::atomic<bool> m_isFinished;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_ASYNC_JOB_HPP
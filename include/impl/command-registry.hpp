@@ -0,0 +1,132 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_COMMAND_REGISTRY_HPP
+#define IMPL_COMMAND_REGISTRY_HPP
+
+#include "../sfml-console.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Open addressing hash table of console commands keyed by name.
+//
+// Commands live in a deque that never moves them, and the table only holds
+// each name's hash and the index of its entry. A CommandHandle is that index
+// plus a generation that changes when the entry is removed, so stale handles
+// are detected instead of invoking whatever reused the slot.
+class CommandRegistry
+{
+public:
+  typedef ConsoleApi::CommandView Command;
+
+  CommandRegistry();
+
+  // Returns an invalid handle if a command with that name already exists
+  CommandHandle
+  insert(std::string_view name, const Command& command);
+
+  bool
+  erase(std::string_view name);
+
+  CommandHandle
+  find(std::string_view name) const;
+
+  // Returns nullptr if the handle is invalid or its command was removed
+  const Command*
+  get(CommandHandle handle) const;
+
+  const std::string*
+  getName(CommandHandle handle) const;
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  // Calls fn(const std::string& name) for each registered command in no
+  // particular order
+  template <typename Function>
+  void
+  forEachName(Function fn) const;
+
+private:
+  struct Entry
+  {
+    std::string name;
+    Command command;
+    uint32_t generation;
+    bool isUsed;
+  };
+
+  struct Slot
+  {
+    uint32_t hash;
+    uint32_t index;
+  };
+
+  static uint32_t
+  hash(std::string_view name);
+
+  // Returns the table position holding name, or the position of the first
+  // reusable slot on its probe sequence if it is not present
+  size_t
+  probe(std::string_view name, uint32_t nameHash, bool& isFound) const;
+
+  void
+  rehash(size_t capacity);
+
+  const Entry*
+  getEntry(CommandHandle handle) const;
+
+private:
+  std::deque<Entry> m_entries;
+  std::vector<uint32_t> m_freeEntries;
+
+  std::vector<Slot> m_slots;
+  size_t m_size;
+  size_t m_tombstones;
+};
+
+template <typename Function>
+void
+CommandRegistry::forEachName(Function fn) const
+{
+  for (const Entry& entry : m_entries) {
+    if (entry.isUsed) {
+      fn(static_cast<const std::string&>(entry.name));
+    }
+  }
+}
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_COMMAND_REGISTRY_HPP
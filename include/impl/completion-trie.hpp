@@ -0,0 +1,114 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_COMPLETION_TRIE_HPP
+#define IMPL_COMPLETION_TRIE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Prefix trie of names used for tab completion.
+//
+// Nodes live in one vector and are never freed, so a node index stays valid
+// across later inserts and erases. That lets the console keep the node for
+// the prefix typed so far and narrow it with step() as each character is
+// typed, instead of searching from the root again. Erasing a name only
+// decrements the name counts along its path.
+class CompletionTrie
+{
+public:
+  typedef uint32_t Node;
+
+  static const Node ROOT;
+  static const Node NO_NODE;
+
+public:
+  CompletionTrie();
+
+  void
+  insert(std::string_view name);
+
+  void
+  erase(std::string_view name);
+
+  // Returns the node for the prefix of node extended by c, or NO_NODE if no
+  // name has that prefix
+  Node
+  step(Node node, char c) const;
+
+  Node
+  find(std::string_view prefix) const;
+
+  Node
+  getParent(Node node) const
+  {
+    return m_nodes[node].parent;
+  }
+
+  // Number of names that start with the node's prefix
+  size_t
+  getCount(Node node) const
+  {
+    return node == NO_NODE ? 0 : m_nodes[node].count;
+  }
+
+  // Appends to out the characters that every name under node shares beyond
+  // the node's prefix and returns the node at the end of them
+  Node
+  extendCommonPrefix(Node node, std::string& out) const;
+
+  // Appends up to limit full names starting with the node's prefix to names,
+  // in sorted order
+  void
+  collect(Node node, size_t limit, std::vector<std::string>& names) const;
+
+private:
+  struct TrieNode
+  {
+    char c;
+    bool isTerminal;
+    uint32_t count;
+    Node parent;
+    Node firstChild;
+    Node nextSibling;
+  };
+
+  Node
+  findChild(Node node, char c) const;
+
+  void
+  collect(Node node, std::string& prefix, size_t limit, std::vector<std::string>& names) const;
+
+private:
+  std::vector<TrieNode> m_nodes;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_COMPLETION_TRIE_HPP
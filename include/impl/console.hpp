@@ -27,12 +27,30 @@
 #include "../sfml-console.hpp"
 
 #include "../style.hpp"
-
-#include <SFML/Graphics/RectangleShape.hpp>
-#include <SFML/Graphics/Text.hpp>
+#include "async-job.hpp"
+#include "command-registry.hpp"
+#include "completion-trie.hpp"
+#include "glyph-advances.hpp"
+#include "input-history.hpp"
+#include "line-editor.hpp"
+#include "log-sink.hpp"
+#include "markup-parser.hpp"
+#include "output-search.hpp"
+#include "print-queue.hpp"
+#include "rate-limiter.hpp"
+#include "script-reader.hpp"
+#include "scrollback.hpp"
+#include "text-batch.hpp"
+#include "tokenizer.hpp"
+#include "worker-pool.hpp"
+#include "wrap-cache.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/Window/Event.hpp>
 
 #include <map>
+#include <memory>
+#include <thread>
 
 namespace sfmlConsole {
 namespace impl {
@@ -40,14 +58,20 @@ namespace impl {
 class Console : public ConsoleApi
 {
 public:
-  typedef std::map<const std::string, Command> CommandMap;
+  typedef std::map<std::string, std::unique_ptr<CvarBase>, std::less<>> CvarMap;
 
   Console(const sf::RenderWindow& window,
           const sf::Font& font,
           Style style = Style::Default);
 
+  // Console that is not attached to a window, laid out as if it were in one
+  // of the given size, so that it can run without a display
+  Console(const sf::Vector2u& windowSize,
+          const sf::Font& font,
+          Style style = Style::Default);
+
   virtual
-  ~Console(){};
+  ~Console();
 
 public:
   virtual void
@@ -71,23 +95,70 @@ public:
   virtual bool
   isVisible() const override;
 
+  virtual void
+  prewarm() override;
+
   virtual void
   print(const std::string& msg) override;
 
+  virtual void
+  print(const std::string& source, const std::string& msg) override;
+
+  virtual void
+  setRateLimit(const std::string& source, double linesPerSecond, size_t burst) override;
+
   virtual void
   clearHistory() override;
 
+  virtual bool
+  exec(const std::string& path) override;
+
+  virtual bool
+  openLog(const std::string& path, size_t maxFileSize = 10 * 1024 * 1024, size_t maxFiles = 3) override;
+
+  virtual void
+  closeLog() override;
+
+  virtual bool
+  openHistory(const std::string& path, size_t capacity = 10000) override;
+
+  using ConsoleApi::registerCommand;
+
   virtual bool
   registerCommand(const std::string& name, const Command& command) override;
 
+  virtual bool
+  registerCommand(const std::string& name, const CommandView& command) override;
+
+  virtual bool
+  registerAsyncCommand(const std::string& name, const AsyncCommand& command) override;
+
   virtual bool
   unregisterCommand(const std::string& name) override;
 
   virtual bool
   isCommand(const std::string& name) const override;
 
-  virtual CommandMap::const_iterator
-  findCommand(const std::string& name) const;
+  virtual CommandHandle
+  findCommand(std::string_view name) const override;
+
+  virtual bool
+  invokeCommand(CommandHandle handle, const CommandParameterViews& params) override;
+
+  virtual IntCvar*
+  registerIntCvar(const std::string& name, int value, const std::string& description = "") override;
+
+  virtual FloatCvar*
+  registerFloatCvar(const std::string& name, float value, const std::string& description = "") override;
+
+  virtual BoolCvar*
+  registerBoolCvar(const std::string& name, bool value, const std::string& description = "") override;
+
+  virtual StringCvar*
+  registerStringCvar(const std::string& name, std::string_view value, const std::string& description = "") override;
+
+  virtual CvarBase*
+  findCvar(std::string_view name) const override;
 
 public:
   bool
@@ -112,6 +183,35 @@ protected:
   void
   scrollHistoryDown();
 
+  // Scrolls the output by pixels, towards older lines for positive ones.
+  // Whole rows move the scroll position, the rest shifts the rows.
+  void
+  scrollPixels(float pixels);
+
+  // Moves part of the way towards the scroll position asked for by the
+  // wheel or by paging, once per frame
+  void
+  updateScroll();
+
+  // Drops any scrolling still to come and any part of a row
+  void
+  stopScrolling();
+
+  // Scrolls the output by rows, towards older lines for up
+  void
+  scrollRowsUp(size_t nRows);
+
+  void
+  scrollRowsDown(size_t nRows);
+
+  // Keeps the oldest row from scrolling down past the top of the output
+  void
+  clampScroll();
+
+  // Rows the line at the given scrollback index wraps to
+  size_t
+  getRowCount(size_t index) const;
+
   void
   scrollInputUp();
 
@@ -130,9 +230,22 @@ protected:
   void
   moveCursorToEnd();
 
+  // Inserts the clipboard at the cursor
+  void
+  paste();
+
+  void
+  complete();
+
+  void
+  resetCompletion();
+
   virtual
   void enterInput();
 
+  void
+  executeLine(std::string_view line);
+
 private:
   void
   setOpen();
@@ -150,28 +263,189 @@ private:
   void
   onWindowResize(const sf::Vector2u& windowSize);
 
+  void
+  layout() const;
+
+  // Fills m_visibleRows with up to nRows rows, working up from the given
+  // scroll position
+  void
+  collectVisibleRows(size_t nRows, size_t scrollOffset, size_t scrollRow) const;
+
+  // Lays out the part of the input around the cursor that fits in the
+  // console
+  void
+  layoutInput(const std::string& cursor) const;
+
+private:
+  template <typename CvarType, typename ValueType>
+  CvarType*
+  registerCvar(const std::string& name, ValueType value, const std::string& description);
+
+  bool
+  isNameTaken(const std::string& name);
+
+  void
+  registerBuiltinCommands();
+
+  void
+  setCvar(CvarBase& cvar, const CommandParameterViews& params);
+
+  void
+  notifyCvarChanges();
+
+private:
+  void
+  startJob(const std::string& name, const CommandParameterViews& params, const AsyncCommand& command);
+
+  // Cancels every running job if params is empty, otherwise the jobs with
+  // the given ids
+  void
+  cancelJobs(const CommandParameterViews& params);
+
+  void
+  finishJobs();
+
+  void
+  runScripts();
+
+private:
+  void
+  beginSearch(const std::string& pattern);
+
+  void
+  endSearch();
+
+  void
+  restartSearch();
+
+  // Returns true if the key was used by the search
+  bool
+  handleSearchKey(const sf::Event::KeyEvent& key);
+
+  // Scrolls to the given index of the search's matches
+  void
+  showMatch(size_t match);
+
+  // Returns true if the key was used by the reverse search of the input
+  // history
+  bool
+  handleHistorySearchKey(const sf::Event::KeyEvent& key);
+
+  // Ends the reverse search, making its match the input
+  void
+  acceptHistoryMatch();
+
+private:
+  void
+  printPerf();
+
+  void
+  drawPerfOverlay(sf::RenderTarget& target, sf::RenderStates states) const;
+
+private:
+  void
+  drainPrintQueue();
+
+  // Drops the line instead if source is over its rate limit
+  void
+  appendLimitedOutput(std::string_view source, const std::string& msg);
+
+  void
+  appendOutput(const std::string& msg, const sf::Color& color);
+
+  // Counts msg as another repeat of the newest line if it is one. Returns
+  // false if it is not.
+  bool
+  countRepeat(size_t hash, const std::string& msg, const sf::Color& color);
+
 private:
   Style m_style;
 
   bool m_isEnabled;
-  size_t m_cursorPosition;
   int m_inputHistoryPosition;
   size_t m_visibleLines;
   int m_slideSpeed;
+  float m_slideOffset;
 
-  std::string m_currentInput;
+  LineEditor m_input;
   std::string m_tempInput;
-  std::string m_cursorMask;
-
-  std::vector<sf::Text> m_outputHistory;
-  std::vector<std::string> m_inputHistory;
-
-  sf::RectangleShape m_border;
-  sf::RectangleShape m_background;
 
-  sf::Text m_prompt;
-
-  CommandMap m_commands;
+  // How far an input wider than the console is scrolled to keep the cursor
+  // in view
+  mutable float m_inputScroll;
+
+  Scrollback m_outputHistory;
+
+  // Splits escapes out of printed lines into the spans they are drawn in
+  MarkupParser m_markup;
+
+  // The output is scrolled back by m_scrollOffset lines from the newest,
+  // and m_scrollRow rows of that line are hidden below the output area
+  size_t m_scrollOffset;
+  size_t m_scrollRow;
+
+  // Rows are shifted up by m_scrollPixel, less than a row, showing part of
+  // the row below the scroll position. m_pendingScroll rows are still to
+  // be scrolled, positive towards older lines.
+  float m_scrollPixel;
+  float m_pendingScroll;
+
+  // Lines printed from threads other than the owner wait here until the
+  // owner drains them in update()
+  PrintQueue m_printQueue;
+  std::thread::id m_ownerThread;
+  RateLimiter m_rateLimiter;
+
+  // A message printed again right after itself only counts up on the line
+  // it was printed on, shown after the text as "x2", "x3" and so on. The
+  // last message is kept as printed, escapes included, so a repeat is found
+  // without parsing it again; its hash rules most other messages out before
+  // comparing the text. m_repeatTextLength is the length of the line's text
+  // before the count.
+  size_t m_repeatLine;
+  size_t m_repeatHash;
+  std::string m_repeatMessage;
+  sf::Color m_repeatColor;
+  size_t m_nRepeats;
+  size_t m_repeatTextLength;
+
+  InputHistory m_inputHistory;
+
+  sf::FloatRect m_border;
+  sf::FloatRect m_background;
+
+  sf::Vector2f m_promptPosition;
+  sf::Vector2f m_inputPosition;
+
+  CommandRegistry m_commands;
+
+  CvarMap m_cvars;
+  CvarBase::PendingList m_changedCvars;
+
+  // Names that Tab completes, and the trie node for the first
+  // m_completionLength characters of the current input. The node is advanced
+  // as characters are typed at the end of the input and reset to the root by
+  // any other edit.
+  CompletionTrie m_completions;
+  CompletionTrie::Node m_completionNode;
+  size_t m_completionLength;
+
+  Tokenizer m_tokenizer;
+  CommandParameterViews m_parameters;
+
+  // Scripts being executed; the last one runs first, so a script that execs
+  // another one continues once the other one has finished
+  std::vector<std::unique_ptr<ScriptReader>> m_scripts;
+
+  // Mirrors every line appended to the output when a log is open
+  std::unique_ptr<LogSink> m_log;
+
+  // While searching, the input holds the pattern and the input being typed
+  // before is kept aside
+  OutputSearch m_search;
+  bool m_isSearching;
+  std::string m_searchSavedInput;
+  size_t m_searchMatch;
 
 private:
   enum class State {
@@ -186,8 +460,36 @@ private:
 private:
   const sf::Font& m_font;
 
-  sf::Text m_sfCurrentInput;
-  sf::Text m_sfCursorMask;
+  // Every quad of the console is laid out into this batch in its open
+  // position and drawn at once, translated by the slide offset. The batch is
+  // only laid out again once something it shows has changed.
+  mutable TextBatch m_batch;
+  mutable bool m_isDirty;
+
+  // Output lines wrap at the width of the output area. Only the lines that
+  // are shown are ever measured.
+  struct VisibleRow
+  {
+    size_t line;
+    uint32_t begin;
+    uint32_t end;
+  };
+
+  mutable WrapCache m_wraps;
+  mutable std::vector<VisibleRow> m_visibleRows;
+
+  // The profiler overlay changes every frame, so it has a batch of its own.
+  // The cvar only exists when the profiler is compiled in.
+  mutable TextBatch m_perfBatch;
+  BoolCvar* m_perfOverlay;
+
+private:
+  std::vector<std::shared_ptr<AsyncJob>> m_jobs;
+  unsigned int m_nextJobId;
+
+  // Declared last so that it is destroyed first, joining the workers while
+  // the rest of the console they print to is still alive
+  WorkerPool m_workerPool;
 
 private:
   static const uint32_t ASCII_BEGIN;
@@ -0,0 +1,94 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_GLYPH_ADVANCES_HPP
+#define IMPL_GLYPH_ADVANCES_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace sf {
+  class Font;
+}
+
+namespace sfmlConsole {
+namespace impl {
+
+// Horizontal advance of each byte at one character size, looked up in the
+// font once and then read from a table. Widths follow TextBatch: kerning
+// with the previous character, tabs four spaces wide, line breaks empty.
+// In monospace mode every character is as wide as a space and there is no
+// kerning to look up, as TextBatch lays out monospace text.
+class GlyphAdvances
+{
+public:
+  GlyphAdvances(const sf::Font& font, unsigned int characterSize);
+
+  // Whether the printable characters of font all have the same advance at
+  // characterSize, judging from a few of the most and least wide ones
+  static bool
+  isMonospace(const sf::Font& font, unsigned int characterSize);
+
+  void
+  setCharacterSize(unsigned int characterSize);
+
+  void
+  setMonospace(bool isMonospace);
+
+  bool
+  isMonospace() const
+  {
+    return m_isMonospace;
+  }
+
+  unsigned int
+  getCharacterSize() const
+  {
+    return m_characterSize;
+  }
+
+  // Width of c, including its kerning with previous. previous is 0 at the
+  // start of a line.
+  float
+  get(uint32_t previous, uint32_t c);
+
+private:
+  const sf::Font& m_font;
+  unsigned int m_characterSize;
+  bool m_isMonospace;
+
+  // Negative until measured
+  std::array<float, 256> m_advances;
+};
+
+// The characters lines wrap at and words end at
+inline bool
+isBlank(char c)
+{
+  return c == ' ' || c == '\t';
+}
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_GLYPH_ADVANCES_HPP
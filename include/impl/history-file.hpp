@@ -0,0 +1,116 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_HISTORY_FILE_HPP
+#define IMPL_HISTORY_FILE_HPP
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Append-only file of input history records.
+//
+// The file is a header followed by records of a 32-bit length and the
+// entry's bytes, in native byte order. Appends are written right away;
+// compaction rewrites the file from a snapshot on a background thread, and
+// the records appended meanwhile are added to the new file when it replaces
+// the old one.
+class HistoryFile
+{
+public:
+  HistoryFile();
+
+  // Waits for a running compaction and finishes it
+  ~HistoryFile();
+
+  HistoryFile(const HistoryFile&) = delete;
+
+  HistoryFile&
+  operator=(const HistoryFile&) = delete;
+
+  // Reads every record of the file into records with a single read,
+  // creating the file if it does not exist. A record cut short by a crash is
+  // removed. Returns false if the file cannot be read or written, or is not
+  // a history file.
+  bool
+  open(const std::string& path, std::string& records);
+
+  bool
+  isOpen() const
+  {
+    return m_file != nullptr;
+  }
+
+  // Writes a record, length prefix included
+  void
+  append(std::string_view record);
+
+  // Starts rewriting the file with only the given records, unless a
+  // compaction is already running
+  void
+  compact(std::string records);
+
+  // Replaces the file once a compaction has been written. Cheap to call
+  // when there is nothing to do.
+  void
+  poll();
+
+  bool
+  isCompacting() const
+  {
+    return m_isCompacting;
+  }
+
+public:
+  static const uint32_t MAGIC;
+  static const uint32_t VERSION;
+
+  // Size of the magic number and version that start the file
+  static const size_t HEADER_SIZE;
+
+private:
+  void
+  finishCompaction();
+
+private:
+  std::string m_path;
+  FILE* m_file;
+
+  std::thread m_compactor;
+  bool m_isCompacting;
+  std::atomic<bool> m_isCompacted;
+  bool m_isCompactionWritten;
+
+  // Records appended while the compaction runs
+  std::string m_pendingRecords;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_HISTORY_FILE_HPP
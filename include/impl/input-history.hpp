@@ -0,0 +1,184 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_INPUT_HISTORY_HPP
+#define IMPL_INPUT_HISTORY_HPP
+
+#include "history-file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Lines entered into the console, oldest first, with a reverse incremental
+// search over them.
+//
+// Entries are kept back to back as length-prefixed records, the same format
+// as the history file, so loading a file is one read followed by building
+// the offsets. Once there are more entries than the capacity, the oldest
+// ones are forgotten, and the file is compacted in the background when it
+// holds twice the capacity.
+//
+// For every character, the history keeps the entries that contain it,
+// updated when a search begins rather than on every push or load. The first
+// character of a query starts from that list, and each further
+// character only filters the matches of the query before it, so typing never
+// rescans the whole history. The matches of every shorter query are kept so
+// that deleting a character is free.
+class InputHistory
+{
+public:
+  static const size_t NO_MATCH;
+
+public:
+  InputHistory();
+
+  // Loads the entries saved in path, followed by the entries already in the
+  // history, and saves every entry pushed from then on. Returns false if the
+  // file cannot be used.
+  bool
+  open(const std::string& path, size_t capacity);
+
+  // Finishes a background compaction of the file once it is done
+  void
+  poll()
+  {
+    m_file.poll();
+  }
+
+  // Ignores empty entries and repeats of the last entry
+  void
+  push(std::string_view entry);
+
+  // Only clears the entries in memory
+  void
+  clear();
+
+  // Index 0 is the oldest entry
+  std::string_view
+  at(size_t index) const
+  {
+    return getEntry(m_first + index);
+  }
+
+  size_t
+  size() const
+  {
+    return m_offsets.size() - m_first;
+  }
+
+  // Starts a search with an empty query, which matches nothing
+  void
+  beginSearch();
+
+  void
+  endSearch();
+
+  bool
+  isSearching() const
+  {
+    return m_isSearching;
+  }
+
+  const std::string&
+  getQuery() const
+  {
+    return m_query;
+  }
+
+  // Appends c to the query and goes back to the newest match
+  void
+  pushSearchCharacter(char c);
+
+  // Removes the last character of the query
+  void
+  popSearchCharacter();
+
+  // Moves to the next older match. Returns false if there is none.
+  bool
+  searchOlder();
+
+  // Index of the current match, or NO_MATCH
+  size_t
+  getMatch() const;
+
+private:
+  typedef std::vector<uint32_t> Matches;
+
+  // Entry by position in m_offsets, including forgotten ones
+  std::string_view
+  getEntry(size_t position) const
+  {
+    uint32_t length;
+    std::memcpy(&length, m_records.data() + m_offsets[position] - sizeof(length), sizeof(length));
+    return std::string_view(m_records.data() + m_offsets[position], length);
+  }
+
+  // Adds the entries pushed since the last search to m_byCharacter
+  void
+  updateIndex();
+
+  // Records of the entries that are not forgotten
+  std::string
+  getLiveRecords() const;
+
+  // Drops the forgotten entries from memory and renumbers the rest
+  void
+  rebuild();
+
+private:
+  std::string m_records;
+
+  // Offset of each entry's text in m_records; the entries before m_first
+  // are forgotten and their space is reclaimed by rebuild()
+  std::vector<size_t> m_offsets;
+  size_t m_first;
+  size_t m_capacity;
+
+  HistoryFile m_file;
+  size_t m_nFileRecords;
+
+  // Entries containing each character, oldest first, by position in
+  // m_offsets. The first m_nIndexed entries are listed.
+  std::vector<Matches> m_byCharacter;
+  size_t m_nIndexed;
+
+  bool m_isSearching;
+  std::string m_query;
+
+  // m_matches[i] holds the entries matching the first i + 1 characters of
+  // the query, oldest first; m_matchRank counts back from the newest one
+  std::vector<Matches> m_matches;
+  size_t m_matchRank;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_INPUT_HISTORY_HPP
@@ -0,0 +1,213 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_LINE_EDITOR_HPP
+#define IMPL_LINE_EDITOR_HPP
+
+#include "glyph-advances.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sf {
+  class Font;
+}
+
+namespace sfmlConsole {
+namespace impl {
+
+// The text of the input line and its cursor.
+//
+// The text is a gap buffer: the free space sits where the last edit was, so
+// typing or deleting at the cursor only moves the characters between the
+// previous edit and this one. Each character also has an extent in a second
+// buffer with the same gap. Before the gap it is the x coordinate of the
+// character's right edge, after the gap the distance from its left edge to
+// the end of the line. Extents are doubles so that they stay exact sums of
+// the advances however long the line gets. An edit changes the extents of
+// at most the edited character and the one after it, and the x coordinate of
+// any position, the cursor's included, is read back in constant time.
+//
+class LineEditor
+{
+public:
+  LineEditor(const sf::Font& font, unsigned int characterSize);
+
+  // Measures the text again if the size changed
+  void
+  setCharacterSize(unsigned int characterSize);
+
+  // Measures the text again, without kerning for a monospace font
+  void
+  setMonospace(bool isMonospace);
+
+  // Inserts at the cursor and moves the cursor past the inserted text
+  void
+  insert(char c);
+
+  void
+  insert(std::string_view text);
+
+  // Replaces the text and moves the cursor to its end
+  void
+  assign(std::string_view text);
+
+  void
+  clear();
+
+  // Deletes the character before the cursor. Returns false at the beginning.
+  bool
+  erase();
+
+  // Deletes the character after the cursor. Returns false at the end.
+  bool
+  eraseForward();
+
+  void
+  moveLeft();
+
+  void
+  moveRight();
+
+  // Moves to the beginning of the word before the cursor
+  void
+  moveWordLeft();
+
+  // Moves to the end of the word after the cursor
+  void
+  moveWordRight();
+
+  void
+  moveToBeginning()
+  {
+    m_cursor = 0;
+  }
+
+  void
+  moveToEnd()
+  {
+    m_cursor = size();
+  }
+
+  size_t
+  getCursor() const
+  {
+    return m_cursor;
+  }
+
+  size_t
+  size() const
+  {
+    return m_text.size() - getGapSize();
+  }
+
+  bool
+  empty() const
+  {
+    return size() == 0;
+  }
+
+  char
+  at(size_t index) const
+  {
+    return index < m_gapBegin ? m_text[index] : m_text[index + getGapSize()];
+  }
+
+  // The whole text. Moves the gap to the end to make the text contiguous,
+  // which is free while the cursor stays at the end.
+  std::string_view
+  getText() const;
+
+  // Copies the characters in [begin, end) to out
+  void
+  copy(size_t begin, size_t end, std::string& out) const;
+
+  // Horizontal advance of the first index characters
+  float
+  getX(size_t index) const;
+
+  float
+  getWidth() const
+  {
+    return static_cast<float>(getWidthBeforeGap() + getWidthAfterGap());
+  }
+
+  // First index whose x coordinate is at least x, or size() if there is none
+  size_t
+  findIndex(float x) const;
+
+private:
+  size_t
+  getGapSize() const
+  {
+    return m_gapEnd - m_gapBegin;
+  }
+
+  double
+  getWidthBeforeGap() const
+  {
+    return m_gapBegin > 0 ? m_extents[m_gapBegin - 1] : 0;
+  }
+
+  double
+  getWidthAfterGap() const
+  {
+    return m_gapEnd < m_extents.size() ? m_extents[m_gapEnd] : 0;
+  }
+
+  // Where the gap is does not change the text, so it moves in const calls
+  void
+  moveGap(size_t position) const;
+
+  // Makes room for at least count characters in the gap
+  void
+  reserveGap(size_t count);
+
+  // Appends c before the gap, leaving the character after the gap to
+  // updateFirstAfterGap()
+  void
+  pushBeforeGap(char c);
+
+  // The width of the first character after the gap depends on the character
+  // before the gap, which an edit may have changed
+  void
+  updateFirstAfterGap();
+
+private:
+  GlyphAdvances m_advances;
+
+  mutable std::vector<char> m_text;
+  mutable std::vector<double> m_extents;
+  mutable size_t m_gapBegin;
+  mutable size_t m_gapEnd;
+
+  size_t m_cursor;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_LINE_EDITOR_HPP
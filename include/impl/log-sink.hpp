@@ -0,0 +1,117 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_LOG_SINK_HPP
+#define IMPL_LOG_SINK_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Appends lines to a log file from a background thread.
+//
+// write() only copies the line into the pending batch; the writer thread
+// swaps the batch out and writes it once it is large enough or the flush
+// interval has passed. When the file would grow past its maximum size it is
+// renamed to path.1 (path.1 to path.2 and so on, up to the number of files
+// kept) and a new one is started.
+class LogSink
+{
+public:
+  LogSink(const std::string& path, size_t maxFileSize, size_t maxFiles);
+
+  // Writes everything still pending before returning
+  ~LogSink();
+
+  LogSink(const LogSink&) = delete;
+
+  LogSink&
+  operator=(const LogSink&) = delete;
+
+  // Whether the file could be opened when the sink was created
+  bool
+  isOpen() const
+  {
+    return m_isOpen;
+  }
+
+  const std::string&
+  getPath() const
+  {
+    return m_path;
+  }
+
+  // Safe to call from any thread and never touches the file. If the writer
+  // has fallen too far behind, the line is dropped and counted in the log.
+  void
+  write(std::string_view line);
+
+public:
+  // Pending size at which the writer is woken before the flush interval
+  static const size_t BATCH_SIZE;
+
+  // Pending size past which lines are dropped
+  static const size_t MAX_PENDING_SIZE;
+
+  static const std::chrono::milliseconds FLUSH_INTERVAL;
+
+private:
+  void
+  run();
+
+  void
+  writeBatch(const std::string& batch);
+
+  void
+  rotate();
+
+private:
+  std::string m_path;
+  size_t m_maxFileSize;
+  size_t m_maxFiles;
+  bool m_isOpen;
+
+  // Only used by the writer thread once it has started
+  FILE* m_file;
+  size_t m_fileSize;
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::string m_pending;
+  size_t m_dropped;
+  bool m_isStopping;
+
+  std::thread m_writer;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_LOG_SINK_HPP
@@ -0,0 +1,101 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_MARKUP_PARSER_HPP
+#define IMPL_MARKUP_PARSER_HPP
+
+#include <SFML/Graphics/Color.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Part of a line drawn in its own color, from begin up to the next span
+struct TextSpan
+{
+  uint32_t begin;
+  sf::Color color;
+  bool isUnderlined;
+};
+
+// Turns ANSI SGR escapes in printed text, such as "\033[31m", into spans.
+//
+// The standard and bright foreground colors (30-37, 90-97), 256 colors
+// (38;5;n), true color (38;2;r;g;b), bold, which brightens the standard
+// colors as terminals do, and underline are understood, and 0 or 39 return
+// to the line's color. Other escapes, including background colors, are
+// removed from the text and otherwise ignored.
+//
+// The text and spans are kept in storage owned by the parser and stay valid
+// until the next call. A line without escapes has no spans.
+class MarkupParser
+{
+public:
+  typedef std::vector<TextSpan> Spans;
+
+  void
+  parse(std::string_view input, const sf::Color& color);
+
+  const std::string&
+  getText() const
+  {
+    return m_text;
+  }
+
+  const Spans&
+  getSpans() const
+  {
+    return m_spans;
+  }
+
+private:
+  // Applies the parameters of one SGR escape
+  void
+  applySgr(std::string_view parameters, const sf::Color& color);
+
+  // Starts a span at the end of the text unless the style is unchanged
+  void
+  beginSpan();
+
+private:
+  std::string m_text;
+  Spans m_spans;
+
+  std::vector<int> m_parameters;
+
+  // Style of the text being parsed; m_colorIndex is the standard color, from
+  // 0 to 7, that bold brightens, or -1
+  sf::Color m_color;
+  int m_colorIndex;
+  bool m_isBold;
+  bool m_isUnderlined;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_MARKUP_PARSER_HPP
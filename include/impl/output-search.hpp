@@ -0,0 +1,154 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_OUTPUT_SEARCH_HPP
+#define IMPL_OUTPUT_SEARCH_HPP
+
+#include "scrollback.hpp"
+#include "search-index.hpp"
+#include "worker-pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Case-insensitive search of the console output, newest line first.
+//
+// A thread of the search's own checks the index's block filters and marks
+// the blocks that may contain the pattern, so long running async commands
+// never hold a search up, nor a search them. The owner then checks the lines of the marked
+// blocks in update(), a bounded number per call, so results fill in over a
+// few frames instead of stalling one. Lines printed after the search started
+// are not searched, and neither are lines older than the newest maxLines.
+class OutputSearch
+{
+public:
+  // Searches the newest maxLines lines at most, whatever the scrollback
+  // still holds
+  explicit
+  OutputSearch(size_t maxLines);
+
+  ~OutputSearch();
+
+  OutputSearch(const OutputSearch&) = delete;
+
+  OutputSearch&
+  operator=(const OutputSearch&) = delete;
+
+  // Indexes the next line of output
+  void
+  add(std::string_view line)
+  {
+    m_index.add(line);
+  }
+
+  // Forgets the lines before firstLine, which the scrollback no longer has
+  void
+  discardBefore(size_t firstLine)
+  {
+    m_index.discardBefore(firstLine);
+  }
+
+  // Stops the search and forgets every line; the next line added is
+  // numbered nextLine
+  void
+  clear(size_t nextLine);
+
+  void
+  start(std::string_view pattern);
+
+  void
+  stop();
+
+  // Checks up to budget lines, of which at most archivedBudget are read
+  // from the scrollback's archive. Returns true if a match was found or the
+  // search has just finished.
+  bool
+  update(const Scrollback& scrollback, size_t budget, size_t archivedBudget);
+
+  bool
+  isRunning() const
+  {
+    return m_isRunning;
+  }
+
+  // Line numbers of the matches, as in Scrollback::getFirstLineNumber(),
+  // newest first
+  const std::vector<size_t>&
+  getMatches() const
+  {
+    return m_matches;
+  }
+
+private:
+  // Filter check of every block, done on a worker thread
+  struct Scan
+  {
+    void
+    run();
+
+    SearchIndex::Blocks blocks;
+    std::vector<uint32_t> trigrams;
+
+    // Element i is for the i-th newest block and is only read once
+    // nScanned is past it
+    std::vector<char> isCandidate;
+    std::atomic<size_t> nScanned;
+    std::atomic<bool> isCancelled;
+  };
+
+  bool
+  isMatch(const Scrollback& scrollback, size_t line);
+
+private:
+  SearchIndex m_index;
+
+  std::shared_ptr<Scan> m_scan;
+  std::string m_pattern;
+  std::string m_lowered;
+  bool m_isRunning;
+
+  // Lines [m_regionBegin, m_nextLine) of the current block are left to
+  // check, and m_nextBlock is the next block of the scan to look at
+  size_t m_firstLine;
+  size_t m_regionBegin;
+  size_t m_nextLine;
+  size_t m_nextBlock;
+
+  std::vector<size_t> m_matches;
+
+  // Declared last so that it is destroyed first, joining a scan that is
+  // still running
+  WorkerPool m_scanner;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_OUTPUT_SEARCH_HPP
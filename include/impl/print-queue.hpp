@@ -0,0 +1,138 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_PRINT_QUEUE_HPP
+#define IMPL_PRINT_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Bounded multi-producer single-consumer queue of messages printed from
+// threads other than the one that owns the console.
+//
+// Each cell reserves room for a message and its source up front, so pushing
+// a message that fits never allocates. Producers never block: when the queue
+// is full the message is dropped and counted instead.
+class PrintQueue
+{
+public:
+  // The capacity is rounded up to a power of two
+  explicit
+  PrintQueue(size_t capacity);
+
+  // Safe to call from any thread. Returns false if the queue was full.
+  bool
+  push(const std::string& msg, std::string_view source = std::string_view());
+
+  // Consumer only. Calls fn(const std::string& msg, const std::string& source)
+  // for each queued message in order and returns how many were consumed. At
+  // most capacity() messages are consumed per call so that busy producers
+  // cannot stall the consumer.
+  template <typename Function>
+  size_t
+  drain(Function fn);
+
+  // Returns the number of messages dropped since the last call
+  size_t
+  takeDropped()
+  {
+    if (m_dropped.load(std::memory_order_relaxed) == 0) {
+      return 0;
+    }
+
+    return m_dropped.exchange(0, std::memory_order_relaxed);
+  }
+
+  // Consumer only. Cheap check used to skip draining an empty queue.
+  bool
+  empty() const
+  {
+    const Cell& cell = m_cells[m_dequeuePos & m_mask];
+    return cell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1;
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_mask + 1;
+  }
+
+public:
+  // Storage reserved per cell; longer messages and sources allocate when
+  // pushed
+  static const size_t MESSAGE_RESERVE;
+  static const size_t SOURCE_RESERVE;
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    std::string text;
+    std::string source;
+  };
+
+  std::unique_ptr<Cell[]> m_cells;
+  size_t m_mask;
+
+  // Keep the producer and consumer positions on separate cache lines
+  alignas(64) std::atomic<size_t> m_enqueuePos;
+  alignas(64) size_t m_dequeuePos;
+
+  std::atomic<size_t> m_dropped;
+};
+
+template <typename Function>
+size_t
+PrintQueue::drain(Function fn)
+{
+  size_t count = 0;
+
+  while (count <= m_mask) {
+    Cell& cell = m_cells[m_dequeuePos & m_mask];
+
+    // The cell is ready once its producer has published position + 1
+    if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1) {
+      break;
+    }
+
+    fn(static_cast<const std::string&>(cell.text), static_cast<const std::string&>(cell.source));
+
+    // Hand the cell back to producers for the next lap around the ring
+    cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+    m_dequeuePos++;
+    count++;
+  }
+
+  return count;
+}
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_PRINT_QUEUE_HPP
@@ -0,0 +1,117 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_RATE_LIMITER_HPP
+#define IMPL_RATE_LIMITER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Token buckets limiting how many lines each source may print.
+//
+// A source may print a burst of lines at once, and then as many lines per
+// second as its bucket refills. Lines over the limit are counted, and the
+// count is handed back once the source has gone a second without a line
+// dropped, so a flood is reported once rather than line by line. Sources
+// without a limit cost one lookup in an empty map.
+class RateLimiter
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  RateLimiter();
+
+  // A rate of zero or less removes the source's limit
+  void
+  setLimit(std::string_view source, double linesPerSecond, size_t burst);
+
+  // Takes a line from the source's bucket. Returns false if the line is
+  // over the limit and should be dropped.
+  bool
+  admit(std::string_view source);
+
+  bool
+  hasDropped() const
+  {
+    return m_nDropping > 0;
+  }
+
+  // Calls fn(const std::string& source, size_t nDropped) for each source
+  // that has stopped going over its limit since it last did
+  template <typename Function>
+  void
+  takeDropped(Function fn);
+
+public:
+  // How long a source must go without a line dropped before its dropped
+  // lines are reported
+  static const Clock::duration QUIET_PERIOD;
+
+private:
+  struct Bucket
+  {
+    double linesPerSecond;
+    double burst;
+    double tokens;
+    Clock::time_point refilled;
+
+    size_t nDropped;
+    Clock::time_point lastDropped;
+  };
+
+  std::map<std::string, Bucket, std::less<>> m_buckets;
+
+  // Buckets with lines dropped and not yet reported
+  size_t m_nDropping;
+};
+
+template <typename Function>
+void
+RateLimiter::takeDropped(Function fn)
+{
+  Clock::time_point now = Clock::now();
+
+  for (auto& entry : m_buckets) {
+    Bucket& bucket = entry.second;
+
+    if (bucket.nDropped > 0 && now - bucket.lastDropped >= QUIET_PERIOD) {
+      size_t nDropped = bucket.nDropped;
+      bucket.nDropped = 0;
+      m_nDropping--;
+
+      fn(static_cast<const std::string&>(entry.first), nDropped);
+    }
+  }
+}
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_RATE_LIMITER_HPP
@@ -0,0 +1,94 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_SCRIPT_READER_HPP
+#define IMPL_SCRIPT_READER_HPP
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Reads a script one line at a time through a fixed-size buffer, so a script
+// of any length is executed without loading it into memory. Blank lines and
+// lines starting with '#' or "//" are skipped.
+class ScriptReader
+{
+public:
+  explicit
+  ScriptReader(const std::string& path);
+
+  ~ScriptReader();
+
+  ScriptReader(const ScriptReader&) = delete;
+
+  ScriptReader&
+  operator=(const ScriptReader&) = delete;
+
+  bool
+  isOpen() const
+  {
+    return m_file != nullptr;
+  }
+
+  const std::string&
+  getPath() const
+  {
+    return m_path;
+  }
+
+  // Points line at the next line, without its line ending. The view is valid
+  // until the next call. Returns false at the end of the file.
+  bool
+  nextLine(std::string_view& line);
+
+  size_t
+  getLineNumber() const
+  {
+    return m_lineNumber;
+  }
+
+private:
+  // Moves the unread bytes to the front of the buffer and reads more after
+  // them. Returns false if nothing more could be read.
+  bool
+  fill();
+
+private:
+  std::string m_path;
+  std::FILE* m_file;
+
+  std::vector<char> m_buffer;
+  size_t m_begin;
+  size_t m_end;
+
+  size_t m_lineNumber;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_SCRIPT_READER_HPP
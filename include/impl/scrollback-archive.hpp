@@ -0,0 +1,175 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_SCROLLBACK_ARCHIVE_HPP
+#define IMPL_SCROLLBACK_ARCHIVE_HPP
+
+#include "markup-parser.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// A line of output that refers to text stored elsewhere. A line without
+// spans is drawn in color.
+struct LineView
+{
+  std::string_view text;
+  sf::Color color;
+  const TextSpan* spans;
+  size_t nSpans;
+};
+
+// On-disk tier of the scrollback, holding every line that has left the
+// in-memory ring.
+//
+// Lines are appended to a segment file as records of a 32-bit color, length
+// and span count followed by the text and the spans, and the offset of each
+// record is appended to an index file, so finding line i is one index read.
+// Both files are written through small buffers and read through windows
+// mapped on demand, so the memory used does not depend on how many lines
+// were archived. The files are unlinked as soon as they are created and
+// disappear with the process.
+// The files need POSIX; on other platforms the archive never opens.
+class ScrollbackArchive
+{
+public:
+  explicit
+  ScrollbackArchive(const std::string& directory);
+
+  ScrollbackArchive(const ScrollbackArchive&) = delete;
+
+  ScrollbackArchive&
+  operator=(const ScrollbackArchive&) = delete;
+
+  // False if the files could not be created or a write has failed, in
+  // which case the archive is empty and ignores further lines
+  bool
+  isOpen() const
+  {
+    return m_isOpen;
+  }
+
+  void
+  append(std::string_view text, const sf::Color& color, const std::vector<TextSpan>& spans);
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  // Index 0 is the oldest line. The view stays valid until the next call to
+  // at(), append() or clear().
+  LineView
+  at(size_t index) const;
+
+  void
+  clear();
+
+public:
+  static const size_t WRITE_BUFFER_SIZE;
+
+  // Granularity of the mapped windows; a multiple of any page size
+  static const size_t MAP_CHUNK_SIZE;
+
+private:
+  // Append-only file without a name
+  class Segment
+  {
+  public:
+    Segment();
+
+    ~Segment();
+
+    Segment(const Segment&) = delete;
+
+    Segment&
+    operator=(const Segment&) = delete;
+
+    bool
+    open(const std::string& directory);
+
+    // Including the bytes still buffered
+    uint64_t
+    size() const
+    {
+      return m_fileSize + m_buffer.size();
+    }
+
+    bool
+    append(const void* data, size_t length);
+
+    // Returns the bytes [offset, offset + length), valid until the next
+    // call, or nullptr if they cannot be read
+    const char*
+    read(uint64_t offset, size_t length);
+
+    bool
+    truncate();
+
+  private:
+    bool
+    flush();
+
+    bool
+    writeAll(const char* data, size_t length);
+
+    void
+    unmap();
+
+  private:
+    int m_fd;
+    uint64_t m_fileSize;
+    std::vector<char> m_buffer;
+
+    char* m_map;
+    uint64_t m_mapOffset;
+    size_t m_mapLength;
+  };
+
+  void
+  fail();
+
+private:
+  mutable Segment m_lines;
+  mutable Segment m_index;
+
+  // Spans of the line returned by at(), decoded from the record
+  mutable std::vector<TextSpan> m_spans;
+
+  size_t m_size;
+  bool m_isOpen;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_SCROLLBACK_ARCHIVE_HPP
@@ -0,0 +1,146 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_SCROLLBACK_HPP
+#define IMPL_SCROLLBACK_HPP
+
+#include "scrollback-archive.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// A single line of console output
+struct Line
+{
+  std::string text;
+  sf::Color color;
+  std::vector<TextSpan> spans;
+};
+
+// Fixed-capacity ring buffer of output lines. Once the buffer has wrapped,
+// pushing a line overwrites the oldest one in place so the string storage of
+// each slot is reused and memory stays flat.
+//
+// Given an archive directory, lines leaving the ring are moved to a
+// ScrollbackArchive on disk instead of being dropped, and indices cover the
+// archived lines followed by the ones in memory.
+class Scrollback
+{
+public:
+  explicit
+  Scrollback(size_t capacity, const std::string& archiveDirectory = "");
+
+  // False if an archive directory was given but the archive could not be
+  // created there
+  bool
+  hasArchive() const
+  {
+    return m_archive && m_archive->isOpen();
+  }
+
+  // Spans, if any, color parts of the text instead of color
+  void
+  push(std::string_view text, const sf::Color& color, const std::vector<TextSpan>& spans = {});
+
+  void
+  clear();
+
+  // Index 0 is the oldest line still held. Archived lines are read from
+  // disk and their text stays valid until the next call.
+  LineView
+  at(size_t index) const
+  {
+    size_t nArchived = getArchivedCount();
+
+    if (index < nArchived) {
+      return m_archive->at(index);
+    }
+
+    const Line& line = m_lines[(m_begin + index - nArchived) % m_lines.size()];
+    return LineView{ line.text, line.color, line.spans.data(), line.spans.size() };
+  }
+
+  // The newest line, which is always in memory. The scrollback must not be
+  // empty.
+  Line&
+  back()
+  {
+    return m_lines[(m_begin + m_size - 1) % m_lines.size()];
+  }
+
+  size_t
+  size() const
+  {
+    return getArchivedCount() + m_size;
+  }
+
+  size_t
+  getArchivedCount() const
+  {
+    return m_archive ? m_archive->size() : 0;
+  }
+
+  // Lines are numbered in the order they were pushed, starting from 0. This
+  // is the number of the line at index 0, which is also how many lines have
+  // been dropped or cleared.
+  size_t
+  getFirstLineNumber() const
+  {
+    return m_nRemoved;
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_lines.size();
+  }
+
+  // Archived lines included, like size()
+  bool
+  empty() const
+  {
+    return size() == 0;
+  }
+
+private:
+  std::vector<Line> m_lines;
+
+  size_t m_begin;
+  size_t m_size;
+  size_t m_nRemoved;
+
+  std::unique_ptr<ScrollbackArchive> m_archive;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_SCROLLBACK_HPP
@@ -0,0 +1,120 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_SEARCH_INDEX_HPP
+#define IMPL_SEARCH_INDEX_HPP
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Block index over the output used to skip lines that cannot match a search.
+//
+// Lines are numbered from the start of the session and grouped into blocks
+// of BLOCK_LINES. Each block has a bloom filter of the case-insensitive
+// trigrams of its lines; a pattern can only occur in a block whose filter
+// has all of the pattern's trigrams. Completed filters never change, so they
+// are shared with searches running on other threads.
+//
+// At most maxBlocks completed filters are kept, so the index stays the same
+// size however long the output grows; older lines are no longer searched.
+class SearchIndex
+{
+public:
+  static constexpr size_t BLOCK_LINES = 128;
+  static constexpr size_t FILTER_BITS = 8192;
+
+  typedef std::bitset<FILTER_BITS> Filter;
+  typedef std::vector<std::shared_ptr<const Filter>> Blocks;
+
+public:
+  explicit
+  SearchIndex(size_t maxBlocks);
+
+  // Indexes the next line
+  void
+  add(std::string_view line);
+
+  // Drops the blocks whose lines are all older than lineNumber
+  void
+  discardBefore(size_t lineNumber);
+
+  // Drops every block; the next line added is numbered nextLineNumber
+  void
+  clear(size_t nextLineNumber);
+
+  // Number of the first line of the oldest block
+  size_t
+  getFirstLineNumber() const
+  {
+    return m_firstLine;
+  }
+
+  // Number of the first line not covered by a completed block
+  size_t
+  getCompletedEnd() const
+  {
+    return m_firstLine + m_blocks.size() * BLOCK_LINES;
+  }
+
+  // Number the next line added will get
+  size_t
+  getNextLineNumber() const
+  {
+    return getCompletedEnd() + m_nCurrentLines;
+  }
+
+  // Completed blocks, oldest first
+  Blocks
+  getCompletedBlocks() const
+  {
+    return Blocks(m_blocks.begin(), m_blocks.end());
+  }
+
+  // Appends the hashes of the case-insensitive trigrams of text
+  static void
+  getTrigrams(std::string_view text, std::vector<uint32_t>& hashes);
+
+  static bool
+  mayContain(const Filter& filter, const std::vector<uint32_t>& hashes);
+
+private:
+  std::deque<std::shared_ptr<const Filter>> m_blocks;
+  size_t m_maxBlocks;
+  size_t m_firstLine;
+
+  std::shared_ptr<Filter> m_current;
+  size_t m_nCurrentLines;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_SEARCH_INDEX_HPP
@@ -0,0 +1,180 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_TEXT_BATCH_HPP
+#define IMPL_TEXT_BATCH_HPP
+
+#include "markup-parser.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace sf {
+  class Font;
+}
+
+namespace sfmlConsole {
+namespace impl {
+
+// Builds text and solid rectangles into a single vertex array of quads
+// textured from the font's glyph atlas, so everything added to the batch is
+// rendered with one draw call.
+//
+// Rectangles are textured from the 2x2 white square SFML reserves at the top
+// left of every font page, which is what sf::Text uses for underlines.
+//
+// With a monospace font, characters are placed one advance apart without
+// kerning, and each byte's quad is read from a table filled from the font
+// once, so laying out a line is a loop over its bytes writing vertices.
+class TextBatch : public sf::Drawable
+{
+public:
+  // Tabs are as wide as this many spaces, as in sf::Text
+  static const int TAB_WIDTH;
+
+public:
+  TextBatch(const sf::Font& font, unsigned int characterSize);
+
+  void
+  setCharacterSize(unsigned int characterSize);
+
+  unsigned int
+  getCharacterSize() const
+  {
+    return m_characterSize;
+  }
+
+  void
+  setMonospace(bool isMonospace);
+
+  bool
+  isMonospace() const
+  {
+    return m_isMonospace;
+  }
+
+  // Removes all quads but keeps the vertex storage for the next frame
+  void
+  clear();
+
+  // Quads added from now on are cut off above top and below bottom, which
+  // clips partly scrolled rows without a second draw call
+  void
+  setClip(float top, float bottom);
+
+  void
+  resetClip();
+
+  void
+  addRect(const sf::FloatRect& rect, const sf::Color& color);
+
+  // Lays out text with its top left corner at (x, y) and returns the x
+  // coordinate following the last character
+  float
+  addText(const std::string& text, float x, float y, const sf::Color& color);
+
+  // previous is the character before begin, if any, for kerning
+  float
+  addText(const char* begin, const char* end, float x, float y, const sf::Color& color, uint32_t previous = 0);
+
+  // Lays out characters [begin, end) of text in the colors of its spans,
+  // underlining the spans that are, with the quads of every span in the
+  // same batch
+  float
+  addSpans(std::string_view text, uint32_t begin, uint32_t end, const TextSpan* spans, size_t nSpans,
+           float x, float y);
+
+  // Returns the horizontal advance of the first @p count characters of text
+  float
+  measure(const std::string& text, size_t count) const;
+
+  size_t
+  getQuadCount() const
+  {
+    return m_vertices.getVertexCount() / 4;
+  }
+
+private:
+  virtual void
+  draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+  // Appends a quad, clipped against m_clipTop and m_clipBottom
+  void
+  addQuad(float left, float top, float right, float bottom, const sf::Color& color,
+          float u1, float v1, float u2, float v2);
+
+  // Writes a quad, clipped against m_clipTop and m_clipBottom, to the four
+  // vertices at quad. Returns false if nothing of it is left.
+  bool
+  writeQuad(sf::Vertex* quad, float left, float top, float right, float bottom, const sf::Color& color,
+            float u1, float v1, float u2, float v2) const;
+
+  float
+  addMonospaceText(const char* begin, const char* end, float x, float y, const sf::Color& color);
+
+private:
+  // A glyph's quad relative to its origin on the baseline
+  struct GlyphQuad
+  {
+    bool isLoaded;
+    float left;
+    float top;
+    float right;
+    float bottom;
+    float u1;
+    float v1;
+    float u2;
+    float v2;
+  };
+
+  const GlyphQuad&
+  getGlyphQuad(unsigned char c);
+
+private:
+  const sf::Font& m_font;
+  unsigned int m_characterSize;
+
+  // The advance shared by every character of a monospace font, and the
+  // quads of the bytes laid out so far at m_characterSize
+  bool m_isMonospace;
+  float m_advance;
+  std::array<GlyphQuad, 256> m_glyphs;
+
+  float m_clipTop;
+  float m_clipBottom;
+
+  sf::VertexArray m_vertices;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_TEXT_BATCH_HPP
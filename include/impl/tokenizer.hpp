@@ -0,0 +1,61 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_TOKENIZER_HPP
+#define IMPL_TOKENIZER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Single pass lexer that splits console input into tokens.
+//
+// Tokens are separated by whitespace. Text in double or single quotes may
+// contain whitespace and the quotes are removed, so 'say "hello world"'
+// yields two tokens. Quoted and unquoted text next to each other joins into
+// one token. Outside single quotes a backslash escapes the next character,
+// and \n and \t stand for a newline and a tab.
+//
+// The returned views point into storage owned by the tokenizer and stay valid
+// until the next call. The storage is reused, so tokenizing does not allocate
+// once it has seen an input of the same length.
+class Tokenizer
+{
+public:
+  typedef std::vector<std::string_view> Tokens;
+
+  const Tokens&
+  tokenize(std::string_view input);
+
+private:
+  std::string m_buffer;
+  Tokens m_tokens;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_TOKENIZER_HPP
@@ -0,0 +1,72 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_WORKER_POOL_HPP
+#define IMPL_WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Small pool of threads that runs tasks in submission order. The threads are
+// only started by the first submit(), so consoles that never run anything
+// asynchronously do not own any threads.
+class WorkerPool
+{
+public:
+  typedef std::function<void()> Task;
+
+  explicit
+  WorkerPool(size_t nThreads);
+
+  // Waits for the running tasks to return; tasks still queued are discarded
+  ~WorkerPool();
+
+  // Only holds the queue lock long enough to append the task
+  void
+  submit(Task task);
+
+private:
+  void
+  run();
+
+private:
+  size_t m_nThreads;
+  std::vector<std::thread> m_threads;
+
+  std::deque<Task> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_isStopping;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_WORKER_POOL_HPP
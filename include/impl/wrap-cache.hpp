@@ -0,0 +1,105 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef IMPL_WRAP_CACHE_HPP
+#define IMPL_WRAP_CACHE_HPP
+
+#include "glyph-advances.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Where each line of output wraps at the current width.
+//
+// A line is measured the first time it is shown rather than when it is
+// printed. Changing the width only starts a new generation, so lines are
+// measured again lazily, once each, as they come back into view. Slots are
+// picked by line number, and consecutive lines never share one, so any
+// window of lines smaller than the cache stays cached however long the
+// history is.
+class WrapCache
+{
+public:
+  // Offsets of the characters that start the second and following rows
+  typedef std::vector<uint32_t> Breaks;
+
+public:
+  WrapCache(const sf::Font& font, unsigned int characterSize, size_t nSlots);
+
+  void
+  setWidth(float width);
+
+  // Measures lines again, without kerning for a monospace font
+  void
+  setMonospace(bool isMonospace);
+
+  float
+  getWidth() const
+  {
+    return m_width;
+  }
+
+  // Measures a line again the next time it is shown, after its text changed
+  void
+  forget(size_t lineNumber);
+
+  const Breaks&
+  getBreaks(size_t lineNumber, std::string_view text);
+
+  size_t
+  getRowCount(size_t lineNumber, std::string_view text)
+  {
+    return getBreaks(lineNumber, text).size() + 1;
+  }
+
+private:
+  // Breaks after the last blank that fits, or within a word that is wider
+  // than a whole row. Blanks may run past the width without breaking.
+  void
+  wrap(std::string_view text, Breaks& breaks);
+
+private:
+  struct Slot
+  {
+    size_t lineNumber;
+    uint32_t generation;
+    Breaks breaks;
+  };
+
+  GlyphAdvances m_advances;
+  float m_width;
+
+  // Slots of older generations are empty
+  uint32_t m_generation;
+  std::vector<Slot> m_slots;
+};
+
+} // namespace impl
+} // namespace sfmlConsole
+
+#endif // IMPL_WRAP_CACHE_HPP
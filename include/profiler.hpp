@@ -0,0 +1,202 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#ifndef SFML_CONSOLE_PROFILER_HPP
+#define SFML_CONSOLE_PROFILER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Scoped timers for the frame profiler. Build with SFML_CONSOLE_PROFILER
+// defined to record them; otherwise they compile to nothing.
+//
+//   void World::update()
+//   {
+//     SFML_CONSOLE_PROFILE_SCOPE("world.update");
+//     ...
+//   }
+//
+// Names must be string literals or otherwise outlive the program's frames.
+#ifdef SFML_CONSOLE_PROFILER
+#define SFML_CONSOLE_PROFILE_CONCAT_(a, b) a##b
+#define SFML_CONSOLE_PROFILE_CONCAT(a, b) SFML_CONSOLE_PROFILE_CONCAT_(a, b)
+#define SFML_CONSOLE_PROFILE_SCOPE(name) \
+  ::sfmlConsole::ScopedTimer SFML_CONSOLE_PROFILE_CONCAT(sfmlConsoleScopedTimer, __LINE__)(name)
+#else
+#define SFML_CONSOLE_PROFILE_SCOPE(name) do {} while (false)
+#endif
+
+namespace sfmlConsole {
+
+// Collects the zones recorded by scoped timers on every thread.
+//
+// Each thread records into its own ring buffer without locking; the console
+// moves the samples into a rolling per-zone history once per update(), which
+// also marks the end of a frame. The history is what the overlay (the
+// perf_overlay cvar) and the perf command show.
+class Profiler
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  // Rolling window of the most recent samples of a zone, in milliseconds
+  class History
+  {
+  public:
+    History();
+
+    void
+    push(float ms);
+
+    void
+    clear();
+
+    size_t
+    size() const
+    {
+      return m_size;
+    }
+
+    // 0 is the oldest sample
+    float
+    at(size_t i) const
+    {
+      return m_samples[(m_next + CAPACITY - m_size + i) % CAPACITY];
+    }
+
+    float
+    mean() const;
+
+    // p in [0, 1]
+    float
+    percentile(float p) const;
+
+  public:
+    static const size_t CAPACITY = 240;
+
+  private:
+    float m_samples[CAPACITY];
+    size_t m_next;
+    size_t m_size;
+  };
+
+  typedef std::map<std::string, History, std::less<>> ZoneMap;
+
+public:
+  static Profiler&
+  instance();
+
+  // Safe to call from any thread and never blocks. If the thread's buffer is
+  // full because nothing collects it, the sample is dropped.
+  void
+  record(const char* name, Clock::time_point start, Clock::time_point end);
+
+  // The remaining functions must be called from the thread that updates the
+  // console.
+
+  // Records the time since the previous call as a frame
+  void
+  endFrame();
+
+  // Moves the samples recorded by every thread into the zone histories
+  void
+  collect();
+
+  void
+  reset();
+
+  const History&
+  getFrames() const
+  {
+    return m_frames;
+  }
+
+  const ZoneMap&
+  getZones() const
+  {
+    return m_zones;
+  }
+
+  // Returns the number of samples dropped since the last call
+  size_t
+  takeDropped();
+
+private:
+  Profiler();
+
+  Profiler(const Profiler&) = delete;
+
+  Profiler&
+  operator=(const Profiler&) = delete;
+
+  struct ThreadBuffer;
+  struct BufferOwner;
+
+  ThreadBuffer*
+  acquireBuffer();
+
+private:
+  // Buffers are never freed; a buffer released by an exited thread is reused
+  // by the next new one
+  std::mutex m_buffersMutex;
+  std::vector<ThreadBuffer*> m_buffers;
+
+  History m_frames;
+  Clock::time_point m_frameStart;
+  ZoneMap m_zones;
+};
+
+// Records the time between its construction and destruction as a zone
+class ScopedTimer
+{
+public:
+  explicit
+  ScopedTimer(const char* name)
+    : m_name(name)
+    , m_start(Profiler::Clock::now())
+  {
+  }
+
+  ~ScopedTimer()
+  {
+    Profiler::instance().record(m_name, m_start, Profiler::Clock::now());
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+
+  ScopedTimer&
+  operator=(const ScopedTimer&) = delete;
+
+private:
+  const char* m_name;
+  Profiler::Clock::time_point m_start;
+};
+
+} // namespace sfmlConsole
+
+#endif // SFML_CONSOLE_PROFILER_HPP
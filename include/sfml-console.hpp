@@ -24,8 +24,16 @@
 #ifndef SFML_CONSOLE_HPP
 #define SFML_CONSOLE_HPP
 
+#include "cvar.hpp"
+#include "style.hpp"
+
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <SFML/Graphics/Drawable.hpp>
@@ -38,6 +46,78 @@ namespace sf {
 
 namespace sfmlConsole {
 
+// Refers to a registered command so it can be invoked without looking up its
+// name. A handle becomes invalid once its command is unregistered.
+class CommandHandle
+{
+public:
+  CommandHandle()
+    : m_index(INVALID_INDEX)
+    , m_generation(0)
+  {
+  }
+
+  CommandHandle(uint32_t index, uint32_t generation)
+    : m_index(index)
+    , m_generation(generation)
+  {
+  }
+
+  uint32_t
+  getIndex() const
+  {
+    return m_index;
+  }
+
+  uint32_t
+  getGeneration() const
+  {
+    return m_generation;
+  }
+
+  // False for handles returned by a failed lookup
+  explicit
+  operator bool() const
+  {
+    return m_index != INVALID_INDEX;
+  }
+
+  bool
+  operator==(const CommandHandle& other) const
+  {
+    return m_index == other.m_index && m_generation == other.m_generation;
+  }
+
+  bool
+  operator!=(const CommandHandle& other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  static const uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+  uint32_t m_index;
+  uint32_t m_generation;
+};
+
+// Passed to asynchronous commands, which run on a worker thread
+class AsyncCommandContext
+{
+public:
+  virtual
+  ~AsyncCommandContext(){};
+
+  // Streams a line into the console; safe to call from the worker thread
+  virtual void
+  print(const std::string& msg) = 0;
+
+  // Set once the command is cancelled from the console; long running commands
+  // should check it periodically and return early
+  virtual bool
+  isCancelled() const = 0;
+};
+
 class ConsoleApi : public sf::Drawable
 {
 public:
@@ -63,25 +143,125 @@ public:
   virtual bool
   isVisible() const = 0;
 
+  // Rasterizes every printable ASCII character at the style's font size into
+  // the font's texture, so that the first frames showing them do not. Done
+  // by the constructor unless the style turns it off. May be called from a
+  // loading thread, as long as nothing draws with the font until it returns.
+  virtual void
+  prewarm() = 0;
+
+  // May be called from any thread. Lines printed from a thread other than
+  // the one that created the console appear after the next update().
+  // ANSI SGR escapes such as "\033[31m" color and underline parts of msg.
+  // A message printed again right after itself counts up on its line
+  // instead, as in "x2".
   virtual void
   print(const std::string& msg) = 0;
 
+  // Like print(), counting the line against the rate limit of source
+  virtual void
+  print(const std::string& source, const std::string& msg) = 0;
+
+  // Lets source print a burst of lines at once and then linesPerSecond lines
+  // a second, dropping the lines over that. How many were dropped is printed
+  // once the source has gone a second without going over. A rate of zero
+  // removes the limit. Lines printed without a source count against the
+  // source "". Call from the thread that created the console.
+  virtual void
+  setRateLimit(const std::string& source, double linesPerSecond, size_t burst) = 0;
+
   virtual void
   clearHistory() = 0;
 
+  // Executes the commands in a file, one per line, over the following
+  // updates. Returns false if the file cannot be opened.
+  virtual bool
+  exec(const std::string& path) = 0;
+
+  // Mirrors everything printed from now on to a log file, appending to it.
+  // The file is written by a background thread; once it would grow past
+  // maxFileSize it is renamed to path.1, and at most maxFiles old files are
+  // kept. Returns false if the file cannot be opened.
+  virtual bool
+  openLog(const std::string& path, size_t maxFileSize = 10 * 1024 * 1024, size_t maxFiles = 3) = 0;
+
+  // Writes whatever is still pending and closes the log file
+  virtual void
+  closeLog() = 0;
+
+  // Loads the input history saved in a file and saves every line entered
+  // from now on, keeping the last capacity lines. Returns false if the file
+  // cannot be read or written.
+  virtual bool
+  openHistory(const std::string& path, size_t capacity = 10000) = 0;
+
 public:
   typedef std::vector<std::string> CommandParameters;
   typedef std::function<void(const CommandParameters&)> Command;
 
+  // Parameters that point into the entered input; they are only valid for the
+  // duration of the call and avoid copying each token into a std::string
+  typedef std::vector<std::string_view> CommandParameterViews;
+  typedef std::function<void(const CommandParameterViews&)> CommandView;
+
+  // Each returns false if the name is already taken by a command or cvar.
+  // findCommand() returns a handle to a registered command.
   virtual bool
   registerCommand(const std::string& name, const Command& command) = 0;
 
+  virtual bool
+  registerCommand(const std::string& name, const CommandView& command) = 0;
+
+  // A callable that takes either kind of parameters, such as a generic
+  // lambda, would convert to both; it is registered as a CommandView
+  template <typename Function,
+            typename = std::enable_if_t<std::is_invocable_v<Function&, const CommandParameters&> &&
+                                        std::is_invocable_v<Function&, const CommandParameterViews&>>>
+  bool
+  registerCommand(const std::string& name, Function command)
+  {
+    return registerCommand(name, CommandView(std::move(command)));
+  }
+
+  typedef std::function<void(const CommandParameters&, AsyncCommandContext&)> AsyncCommand;
+
+  // Registers a command that runs on a worker thread instead of blocking the
+  // thread that updates the console. Running commands can be cancelled with
+  // Ctrl+C or the "cancel" command.
+  virtual bool
+  registerAsyncCommand(const std::string& name, const AsyncCommand& command) = 0;
+
   virtual bool
   unregisterCommand(const std::string& name) = 0;
 
   virtual bool
   isCommand(const std::string& name) const = 0;
 
+  // Returns an invalid handle if no command has that name
+  virtual CommandHandle
+  findCommand(std::string_view name) const = 0;
+
+  // Returns false if the handle's command is no longer registered
+  virtual bool
+  invokeCommand(CommandHandle handle, const CommandParameterViews& params) = 0;
+
+public:
+  // Each returns nullptr if the name is already taken by a command or cvar
+  virtual IntCvar*
+  registerIntCvar(const std::string& name, int value, const std::string& description = "") = 0;
+
+  virtual FloatCvar*
+  registerFloatCvar(const std::string& name, float value, const std::string& description = "") = 0;
+
+  virtual BoolCvar*
+  registerBoolCvar(const std::string& name, bool value, const std::string& description = "") = 0;
+
+  virtual StringCvar*
+  registerStringCvar(const std::string& name, std::string_view value, const std::string& description = "") = 0;
+
+  virtual CvarBase*
+  findCvar(std::string_view name) const = 0;
+
   virtual void
   draw(sf::RenderTarget& target, sf::RenderStates states) const = 0;
 };
@@ -91,6 +271,8 @@ class SfmlConsole : public ConsoleApi
 public:
   SfmlConsole(const sf::RenderWindow& window, const sf::Font& font);
 
+  SfmlConsole(const sf::RenderWindow& window, const sf::Font& font, const Style& style);
+
   virtual
   ~SfmlConsole(){};
 
@@ -113,25 +295,73 @@ public:
   virtual bool
   isVisible() const override;
 
+  virtual void
+  prewarm() override;
+
   virtual void
   print(const std::string& msg) override;
 
+  virtual void
+  print(const std::string& source, const std::string& msg) override;
+
+  virtual void
+  setRateLimit(const std::string& source, double linesPerSecond, size_t burst) override;
+
   virtual void
   clearHistory() override;
 
+  virtual bool
+  exec(const std::string& path) override;
+
+  virtual bool
+  openLog(const std::string& path, size_t maxFileSize = 10 * 1024 * 1024, size_t maxFiles = 3) override;
+
+  virtual void
+  closeLog() override;
+
+  virtual bool
+  openHistory(const std::string& path, size_t capacity = 10000) override;
+
 public:
-  typedef std::vector<std::string> CommandParameters;
-  typedef std::function<void(const CommandParameters&)> Command;
+  using ConsoleApi::registerCommand;
 
   virtual bool
   registerCommand(const std::string& name, const Command& command) override;
 
+  virtual bool
+  registerCommand(const std::string& name, const CommandView& command) override;
+
+  virtual bool
+  registerAsyncCommand(const std::string& name, const AsyncCommand& command) override;
+
   virtual bool
   unregisterCommand(const std::string& name) override;
 
   virtual bool
   isCommand(const std::string& name) const override;
 
+  virtual CommandHandle
+  findCommand(std::string_view name) const override;
+
+  virtual bool
+  invokeCommand(CommandHandle handle, const CommandParameterViews& params) override;
+
+public:
+  virtual IntCvar*
+  registerIntCvar(const std::string& name, int value, const std::string& description = "") override;
+
+  virtual FloatCvar*
+  registerFloatCvar(const std::string& name, float value, const std::string& description = "") override;
+
+  virtual BoolCvar*
+  registerBoolCvar(const std::string& name, bool value, const std::string& description = "") override;
+
+  virtual StringCvar*
+  registerStringCvar(const std::string& name, std::string_view value, const std::string& description = "") override;
+
+  virtual CvarBase*
+  findCvar(std::string_view name) const override;
+
   virtual void
   draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
@@ -27,11 +27,22 @@
 #include <SFML/Graphics/Color.hpp>
 
 #include <cstddef>
+#include <string>
 
 namespace sfmlConsole {
 
 class Style
 {
+public:
+  // How text is measured and laid out. Monospace text is placed one advance
+  // apart without kerning, which is cheaper; DETECT uses it when the font's
+  // characters all have the same advance.
+  enum class FontSpacing {
+    DETECT = 0,
+    MONOSPACE,
+    PROPORTIONAL
+  };
+
 public:
   Style(size_t fontSize,
         double heightPercentage,
@@ -40,7 +51,8 @@ public:
         char cursorCharacter,
         sf::Color borderColor,
         sf::Color backgroundColor,
-        sf::Color fontColor);
+        sf::Color fontColor,
+        size_t scrollbackSize = DEFAULT_SCROLLBACK_SIZE);
 public:
   size_t
   getFontSize() const
@@ -90,6 +102,36 @@ public:
     return m_fontColor;
   }
 
+  size_t
+  getScrollbackSize() const
+  {
+    return m_scrollbackSize;
+  }
+
+  size_t
+  getScriptLinesPerFrame() const
+  {
+    return m_scriptLinesPerFrame;
+  }
+
+  const std::string&
+  getScrollbackArchiveDirectory() const
+  {
+    return m_scrollbackArchiveDirectory;
+  }
+
+  bool
+  isPrewarmingGlyphs() const
+  {
+    return m_isPrewarmingGlyphs;
+  }
+
+  FontSpacing
+  getFontSpacing() const
+  {
+    return m_fontSpacing;
+  }
+
 public:
   void
   setFontSize(size_t size)
@@ -139,9 +181,57 @@ public:
     m_fontColor = color;
   }
 
+  // Maximum number of output lines kept; takes effect when a console is
+  // constructed with this style
+  void
+  setScrollbackSize(size_t nLines)
+  {
+    m_scrollbackSize = nLines;
+  }
+
+  // Maximum number of script lines executed per update(), so that a long
+  // script does not stall rendering
+  void
+  setScriptLinesPerFrame(size_t nLines)
+  {
+    m_scriptLinesPerFrame = nLines;
+  }
+
+  // Directory in which lines that no longer fit in the scrollback are kept,
+  // in a file that is removed when the console is destroyed. Empty, the
+  // default, drops them instead. Takes effect when a console is constructed
+  // with this style. Only supported on POSIX systems; elsewhere old lines
+  // are always dropped.
+  void
+  setScrollbackArchiveDirectory(const std::string& directory)
+  {
+    m_scrollbackArchiveDirectory = directory;
+  }
+
+  // Whether a console constructed with this style rasterizes the printable
+  // characters right away, which is the default. Turn it off to call
+  // prewarm() later, from a loading thread for instance.
+  void
+  setPrewarmingGlyphs(bool isPrewarming)
+  {
+    m_isPrewarmingGlyphs = isPrewarming;
+  }
+
+  // DETECT by default. Takes effect when a console is constructed with this
+  // style.
+  void
+  setFontSpacing(FontSpacing spacing)
+  {
+    m_fontSpacing = spacing;
+  }
+
 public:
   static const Style Default;
 
+  static const size_t DEFAULT_SCROLLBACK_SIZE;
+
+  static const size_t DEFAULT_SCRIPT_LINES_PER_FRAME;
+
 private:
   size_t m_fontSize;
   double m_heightPercentage;
@@ -152,6 +242,12 @@ private:
   sf::Color m_borderColor;
   sf::Color m_backgroundColor;
   sf::Color m_fontColor;
+
+  size_t m_scrollbackSize;
+  size_t m_scriptLinesPerFrame;
+  std::string m_scrollbackArchiveDirectory;
+  bool m_isPrewarmingGlyphs;
+  FontSpacing m_fontSpacing;
 };
 
 } // namespace sfmlConsole
@@ -0,0 +1,72 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "async-job.hpp"
+
+namespace sfmlConsole {
+namespace impl {
+
+//=============================================================================
+//  AsyncJob::AsyncJob()
+//-----------------------------------------------------------------------------
+AsyncJob::AsyncJob(ConsoleApi& console,
+                   unsigned int id,
+                   const std::string& name,
+                   const ConsoleApi::CommandParameterViews& params,
+                   const ConsoleApi::AsyncCommand& command)
+  : m_console(console)
+  , m_id(id)
+  , m_name(name)
+  , m_params(params.begin(), params.end())
+  , m_command(command)
+  , m_isCancelled(false)
+  , m_isFinished(false)
+{
+}
+
+//=============================================================================
+//  void AsyncJob::run()
+//-----------------------------------------------------------------------------
+void
+AsyncJob::run()
+{
+  if (!isCancelled()) {
+    m_command(m_params, *this);
+  }
+
+  // Release so that everything the command printed is queued before the
+  // console sees the job as finished
+  m_isFinished.store(true, std::memory_order_release);
+}
+
+//=============================================================================
+//  void AsyncJob::print()
+//-----------------------------------------------------------------------------
+void
+AsyncJob::print(const std::string& msg)
+{
+  m_console.print(msg);
+}
+
+} // namespace impl
+} // namespace sfmlConsole
@@ -0,0 +1,252 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "command-registry.hpp"
+
+namespace sfmlConsole {
+namespace impl {
+
+const uint32_t EMPTY_SLOT = 0xFFFFFFFF;
+const uint32_t TOMBSTONE_SLOT = 0xFFFFFFFE;
+
+const size_t INITIAL_CAPACITY = 16;
+
+//=============================================================================
+//  CommandRegistry::CommandRegistry()
+//-----------------------------------------------------------------------------
+CommandRegistry::CommandRegistry()
+  : m_slots(INITIAL_CAPACITY, Slot{0, EMPTY_SLOT})
+  , m_size(0)
+  , m_tombstones(0)
+{
+}
+
+//=============================================================================
+//  uint32_t CommandRegistry::hash()
+//-----------------------------------------------------------------------------
+uint32_t
+CommandRegistry::hash(std::string_view name)
+{
+  // FNV-1a
+  uint32_t h = 2166136261u;
+
+  for (char c : name) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 16777619u;
+  }
+
+  return h;
+}
+
+//=============================================================================
+//  size_t CommandRegistry::probe()
+//-----------------------------------------------------------------------------
+size_t
+CommandRegistry::probe(std::string_view name, uint32_t nameHash, bool& isFound) const
+{
+  size_t mask = m_slots.size() - 1;
+  size_t pos = nameHash & mask;
+  size_t reusable = EMPTY_SLOT;
+
+  for (;;) {
+    const Slot& slot = m_slots[pos];
+
+    if (slot.index == EMPTY_SLOT) {
+      isFound = false;
+      return reusable != EMPTY_SLOT ? reusable : pos;
+    }
+    else if (slot.index == TOMBSTONE_SLOT) {
+      if (reusable == EMPTY_SLOT) {
+        reusable = pos;
+      }
+    }
+    else if (slot.hash == nameHash && m_entries[slot.index].name == name) {
+      isFound = true;
+      return pos;
+    }
+
+    pos = (pos + 1) & mask;
+  }
+}
+
+//=============================================================================
+//  void CommandRegistry::rehash()
+//-----------------------------------------------------------------------------
+void
+CommandRegistry::rehash(size_t capacity)
+{
+  std::vector<Slot> slots(capacity, Slot{0, EMPTY_SLOT});
+  size_t mask = capacity - 1;
+
+  for (const Slot& slot : m_slots) {
+    if (slot.index == EMPTY_SLOT || slot.index == TOMBSTONE_SLOT) {
+      continue;
+    }
+
+    size_t pos = slot.hash & mask;
+    while (slots[pos].index != EMPTY_SLOT) {
+      pos = (pos + 1) & mask;
+    }
+
+    slots[pos] = slot;
+  }
+
+  m_slots.swap(slots);
+  m_tombstones = 0;
+}
+
+//=============================================================================
+//  CommandHandle CommandRegistry::insert()
+//-----------------------------------------------------------------------------
+CommandHandle
+CommandRegistry::insert(std::string_view name, const Command& command)
+{
+  // Keep the load factor, tombstones included, at or below one half
+  if ((m_size + m_tombstones + 1) * 2 > m_slots.size()) {
+    rehash(m_size * 4 > m_slots.size() ? m_slots.size() * 2 : m_slots.size());
+  }
+
+  uint32_t nameHash = hash(name);
+  bool isFound;
+  size_t pos = probe(name, nameHash, isFound);
+
+  if (isFound) {
+    return CommandHandle();
+  }
+
+  uint32_t index;
+
+  if (!m_freeEntries.empty()) {
+    index = m_freeEntries.back();
+    m_freeEntries.pop_back();
+  }
+  else {
+    index = static_cast<uint32_t>(m_entries.size());
+    m_entries.push_back(Entry{std::string(), Command(), 0, false});
+  }
+
+  Entry& entry = m_entries[index];
+  entry.name.assign(name);
+  entry.command = command;
+  entry.isUsed = true;
+
+  if (m_slots[pos].index == TOMBSTONE_SLOT) {
+    m_tombstones--;
+  }
+
+  m_slots[pos] = Slot{nameHash, index};
+  m_size++;
+
+  return CommandHandle(index, entry.generation);
+}
+
+//=============================================================================
+//  bool CommandRegistry::erase()
+//-----------------------------------------------------------------------------
+bool
+CommandRegistry::erase(std::string_view name)
+{
+  bool isFound;
+  size_t pos = probe(name, hash(name), isFound);
+
+  if (!isFound) {
+    return false;
+  }
+
+  uint32_t index = m_slots[pos].index;
+  Entry& entry = m_entries[index];
+
+  entry.name.clear();
+  entry.command = nullptr;
+  entry.isUsed = false;
+
+  // Invalidate every handle to this entry
+  entry.generation++;
+
+  m_freeEntries.push_back(index);
+
+  m_slots[pos].index = TOMBSTONE_SLOT;
+  m_tombstones++;
+  m_size--;
+
+  return true;
+}
+
+//=============================================================================
+//  CommandHandle CommandRegistry::find()
+//-----------------------------------------------------------------------------
+CommandHandle
+CommandRegistry::find(std::string_view name) const
+{
+  bool isFound;
+  size_t pos = probe(name, hash(name), isFound);
+
+  if (!isFound) {
+    return CommandHandle();
+  }
+
+  uint32_t index = m_slots[pos].index;
+  return CommandHandle(index, m_entries[index].generation);
+}
+
+//=============================================================================
+//  const Entry* CommandRegistry::getEntry()
+//-----------------------------------------------------------------------------
+const CommandRegistry::Entry*
+CommandRegistry::getEntry(CommandHandle handle) const
+{
+  if (!handle || handle.getIndex() >= m_entries.size()) {
+    return nullptr;
+  }
+
+  const Entry& entry = m_entries[handle.getIndex()];
+
+  if (!entry.isUsed || entry.generation != handle.getGeneration()) {
+    return nullptr;
+  }
+
+  return &entry;
+}
+
+//=============================================================================
+//  const Command* CommandRegistry::get()
+//-----------------------------------------------------------------------------
+const CommandRegistry::Command*
+CommandRegistry::get(CommandHandle handle) const
+{
+  const Entry* entry = getEntry(handle);
+  return entry != nullptr ? &entry->command : nullptr;
+}
+
+//=============================================================================
+//  const std::string* CommandRegistry::getName()
+//-----------------------------------------------------------------------------
+const std::string*
+CommandRegistry::getName(CommandHandle handle) const
+{
+  const Entry* entry = getEntry(handle);
+  return entry != nullptr ? &entry->name : nullptr;
+}
+
+} // namespace impl
+} // namespace sfmlConsole
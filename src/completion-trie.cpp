@@ -0,0 +1,225 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "completion-trie.hpp"
+
+namespace sfmlConsole {
+namespace impl {
+
+const CompletionTrie::Node CompletionTrie::ROOT = 0;
+const CompletionTrie::Node CompletionTrie::NO_NODE = 0xFFFFFFFF;
+
+//=============================================================================
+//  CompletionTrie::CompletionTrie()
+//-----------------------------------------------------------------------------
+CompletionTrie::CompletionTrie()
+{
+  m_nodes.push_back(TrieNode{0, false, 0, NO_NODE, NO_NODE, NO_NODE});
+}
+
+//=============================================================================
+//  Node CompletionTrie::findChild()
+//-----------------------------------------------------------------------------
+CompletionTrie::Node
+CompletionTrie::findChild(Node node, char c) const
+{
+  // Children are kept sorted, so the search can stop early
+  for (Node child = m_nodes[node].firstChild; child != NO_NODE; child = m_nodes[child].nextSibling) {
+    if (m_nodes[child].c == c) {
+      return child;
+    }
+    else if (m_nodes[child].c > c) {
+      break;
+    }
+  }
+
+  return NO_NODE;
+}
+
+//=============================================================================
+//  void CompletionTrie::insert()
+//-----------------------------------------------------------------------------
+void
+CompletionTrie::insert(std::string_view name)
+{
+  Node node = ROOT;
+  m_nodes[node].count++;
+
+  for (char c : name) {
+    // Find the sorted position of c among the children
+    Node previous = NO_NODE;
+    Node child = m_nodes[node].firstChild;
+
+    while (child != NO_NODE && m_nodes[child].c < c) {
+      previous = child;
+      child = m_nodes[child].nextSibling;
+    }
+
+    if (child == NO_NODE || m_nodes[child].c != c) {
+      Node created = static_cast<Node>(m_nodes.size());
+      m_nodes.push_back(TrieNode{c, false, 0, node, NO_NODE, child});
+
+      if (previous == NO_NODE) {
+        m_nodes[node].firstChild = created;
+      }
+      else {
+        m_nodes[previous].nextSibling = created;
+      }
+
+      child = created;
+    }
+
+    node = child;
+    m_nodes[node].count++;
+  }
+
+  m_nodes[node].isTerminal = true;
+}
+
+//=============================================================================
+//  void CompletionTrie::erase()
+//-----------------------------------------------------------------------------
+void
+CompletionTrie::erase(std::string_view name)
+{
+  Node node = find(name);
+
+  if (node == NO_NODE || !m_nodes[node].isTerminal) {
+    return;
+  }
+
+  m_nodes[node].isTerminal = false;
+
+  for (; node != NO_NODE; node = m_nodes[node].parent) {
+    m_nodes[node].count--;
+  }
+}
+
+//=============================================================================
+//  Node CompletionTrie::step()
+//-----------------------------------------------------------------------------
+CompletionTrie::Node
+CompletionTrie::step(Node node, char c) const
+{
+  if (node == NO_NODE) {
+    return NO_NODE;
+  }
+
+  Node child = findChild(node, c);
+
+  if (child == NO_NODE || m_nodes[child].count == 0) {
+    return NO_NODE;
+  }
+
+  return child;
+}
+
+//=============================================================================
+//  Node CompletionTrie::find()
+//-----------------------------------------------------------------------------
+CompletionTrie::Node
+CompletionTrie::find(std::string_view prefix) const
+{
+  Node node = ROOT;
+
+  for (char c : prefix) {
+    node = step(node, c);
+  }
+
+  return node;
+}
+
+//=============================================================================
+//  Node CompletionTrie::extendCommonPrefix()
+//-----------------------------------------------------------------------------
+CompletionTrie::Node
+CompletionTrie::extendCommonPrefix(Node node, std::string& out) const
+{
+  if (node == NO_NODE) {
+    return NO_NODE;
+  }
+
+  // Follow the path while it does not branch and no name ends along it
+  while (!m_nodes[node].isTerminal) {
+    Node next = NO_NODE;
+
+    for (Node child = m_nodes[node].firstChild; child != NO_NODE; child = m_nodes[child].nextSibling) {
+      if (m_nodes[child].count == m_nodes[node].count) {
+        next = child;
+        break;
+      }
+      else if (m_nodes[child].count > 0) {
+        break;
+      }
+    }
+
+    if (next == NO_NODE) {
+      break;
+    }
+
+    out.push_back(m_nodes[next].c);
+    node = next;
+  }
+
+  return node;
+}
+
+//=============================================================================
+//  void CompletionTrie::collect()
+//-----------------------------------------------------------------------------
+void
+CompletionTrie::collect(Node node, size_t limit, std::vector<std::string>& names) const
+{
+  if (node == NO_NODE) {
+    return;
+  }
+
+  // Rebuild the node's prefix by walking up to the root
+  std::string prefix;
+  for (Node it = node; it != ROOT; it = m_nodes[it].parent) {
+    prefix.insert(prefix.begin(), m_nodes[it].c);
+  }
+
+  collect(node, prefix, limit, names);
+}
+
+void
+CompletionTrie::collect(Node node, std::string& prefix, size_t limit, std::vector<std::string>& names) const
+{
+  if (names.size() >= limit || m_nodes[node].count == 0) {
+    return;
+  }
+
+  if (m_nodes[node].isTerminal) {
+    names.push_back(prefix);
+  }
+
+  for (Node child = m_nodes[node].firstChild; child != NO_NODE; child = m_nodes[child].nextSibling) {
+    prefix.push_back(m_nodes[child].c);
+    collect(child, prefix, limit, names);
+    prefix.pop_back();
+  }
+}
+
+} // namespace impl
+} // namespace sfmlConsole
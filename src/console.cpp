@@ -22,13 +22,16 @@
 */
 
 #include "console.hpp"
+#include "../profiler.hpp"
 
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Window/Clipboard.hpp>
 #include <SFML/Window/Event.hpp>
 
 #include <algorithm>
-#include <regex>
+#include <cmath>
+#include <cstdio>
 
 namespace sfmlConsole {
 namespace impl {
@@ -39,301 +42,1871 @@ const char Console::CURSOR_CHARACTER = '_';
 
 const int INPUT_HISTORY_NO_POSITION = -1;
 
+const size_t PRINT_QUEUE_CAPACITY = 4096;
+
+const size_t MAX_COMPLETIONS_LISTED = 16;
+
+const size_t ASYNC_WORKER_COUNT = 2;
+
+const size_t MAX_SCRIPT_DEPTH = 16;
+
+const size_t SEARCH_LINES_PER_FRAME = 20000;
+
+// Lines read back from the scrollback archive by a search, per frame
+const size_t SEARCH_ARCHIVED_LINES_PER_FRAME = 500;
+
+// Archived lines searched besides the scrollback in memory; each block of
+// SearchIndex::BLOCK_LINES of them keeps a 1 KiB filter
+const size_t SEARCHED_ARCHIVE_LINES = 128 * 1024;
+
+const size_t NO_MATCH = static_cast<size_t>(-1);
+
+const char SEARCH_PROMPT_CHARACTER = '/';
+
+const sf::Color MATCH_HIGHLIGHT_COLOR(255, 255, 0, 96);
+
+// Lines whose wrapping is remembered, many screens' worth
+const size_t WRAP_CACHE_SLOTS = 4096;
+
+// Rows scrolled by one notch of the mouse wheel
+const float WHEEL_ROWS = 3;
+
+// Characters rasterized by prewarm()
+const uint32_t PREWARM_BEGIN = ' ';
+const uint32_t PREWARM_END = '~';
+
+// Share of the remaining scroll distance covered each frame, and the
+// distance, in rows, below which the rest is covered at once
+const float SCROLL_SMOOTHING = 0.35f;
+const float SCROLL_SNAP_ROWS = 0.05f;
+
 //=============================================================================
 //  Console::Console()
 //-----------------------------------------------------------------------------
 Console::Console(const sf::RenderWindow& window, const sf::Font& font, Style style)
+  : Console(window.getSize(), font, style)
+{
+}
+
+Console::Console(const sf::Vector2u& windowSize, const sf::Font& font, Style style)
   : m_font(font)
   , m_style(style)
   , m_isEnabled(false)
   , m_slideSpeed(5)
   , m_visibleLines(10)
-  , m_currentInput("")
-  , m_cursorMask("")
+  , m_input(font, style.getFontSize())
   , m_tempInput("")
+  , m_inputScroll(0)
   , m_inputHistoryPosition(INPUT_HISTORY_NO_POSITION)
-  , m_cursorPosition(0)
+  , m_outputHistory(style.getScrollbackSize(), style.getScrollbackArchiveDirectory())
+  , m_scrollOffset(0)
+  , m_scrollRow(0)
+  , m_scrollPixel(0)
+  , m_pendingScroll(0)
+  , m_search(style.getScrollbackSize() + SEARCHED_ARCHIVE_LINES)
+  , m_isSearching(false)
+  , m_searchMatch(NO_MATCH)
+  , m_printQueue(PRINT_QUEUE_CAPACITY)
+  , m_ownerThread(std::this_thread::get_id())
+  , m_repeatLine(NO_MATCH)
+  , m_repeatHash(0)
+  , m_nRepeats(0)
+  , m_repeatTextLength(0)
+  , m_state(State::CLOSED)
+  , m_batch(font, style.getFontSize())
+  , m_isDirty(true)
+  , m_wraps(font, style.getFontSize(), WRAP_CACHE_SLOTS)
+  , m_perfBatch(font, style.getFontSize())
+  , m_perfOverlay(nullptr)
+  , m_completionNode(CompletionTrie::ROOT)
+  , m_completionLength(0)
+  , m_changedCvars(nullptr)
+  , m_nextJobId(1)
+  , m_workerPool(ASYNC_WORKER_COUNT)
 {
-  // Initialize style
-  m_border.setFillColor(m_style.getBorderColor());
-  m_background.setFillColor(m_style.getBackgroundColor());
-
-  m_sfCurrentInput.setFont(font);
-  m_sfCursorMask.setFont(font);
+  unsigned int characterSize = static_cast<unsigned int>(style.getFontSize());
+  bool isMonospace = style.getFontSpacing() == Style::FontSpacing::MONOSPACE ||
+                     (style.getFontSpacing() == Style::FontSpacing::DETECT &&
+                      GlyphAdvances::isMonospace(font, characterSize));
 
-  m_prompt.setString(m_style.getPromptCharacter());
-  m_prompt.setFont(font);
-  m_prompt.setColor(m_style.getFontColor());
+  m_input.setMonospace(isMonospace);
+  m_batch.setMonospace(isMonospace);
+  m_wraps.setMonospace(isMonospace);
+  m_perfBatch.setMonospace(isMonospace);
 
   // Initialize console size
-  onWindowResize(window.getSize());
+  onWindowResize(windowSize);
+
+  registerBuiltinCommands();
+
+  if (!style.getScrollbackArchiveDirectory().empty() && !m_outputHistory.hasArchive()) {
+    print("Cannot keep scrollback in \"" + style.getScrollbackArchiveDirectory() + "\", old lines will be dropped");
+  }
+
+  // Start out of view, above the window
+  m_slideOffset = -m_border.height;
+
+  if (style.isPrewarmingGlyphs()) {
+    prewarm();
+  }
+}
+
+//=============================================================================
+//  Console::~Console()
+//-----------------------------------------------------------------------------
+Console::~Console()
+{
+  // Ask running jobs to stop; the worker pool waits for them to return
+  for (const std::shared_ptr<AsyncJob>& job : m_jobs) {
+    job->cancel();
+  }
+}
+
+//=============================================================================
+//  void Console::handleEvent()
+//-----------------------------------------------------------------------------
+void
+Console::handleEvent(const sf::Event& event)
+{
+  if (!m_isEnabled) {
+    return;
+  }
+
+  if (event.type == sf::Event::KeyPressed) {
+    // Most keys edit the input or move the cursor
+    m_isDirty = true;
+
+    if (m_inputHistory.isSearching() && handleHistorySearchKey(event.key)) {
+      return;
+    }
+
+    if (event.key.code == sf::Keyboard::R && event.key.control) {
+      // Again while searching, look further back
+      if (m_inputHistory.isSearching()) {
+        m_inputHistory.searchOlder();
+      }
+      else if (!m_isSearching) {
+        m_inputHistory.beginSearch();
+      }
+    }
+    else if (event.key.code == sf::Keyboard::F && event.key.control) {
+      if (m_isSearching) {
+        endSearch();
+      }
+      else {
+        beginSearch("");
+      }
+    }
+    else if (m_isSearching && handleSearchKey(event.key)) {
+      return;
+    }
+    else if (event.key.code == sf::Keyboard::Up) {
+      scrollInputUp();
+      moveCursorToEnd();
+      resetCompletion();
+    }
+    else if (event.key.code == sf::Keyboard::Down) {
+      scrollInputDown();
+      moveCursorToEnd();
+      resetCompletion();
+    }
+    else if (event.key.code == sf::Keyboard::Tab) {
+      complete();
+    }
+    else if (event.key.code == sf::Keyboard::Left) {
+      if (event.key.control) {
+        m_input.moveWordLeft();
+      }
+      else {
+        moveCursorLeft();
+      }
+    }
+    else if (event.key.code == sf::Keyboard::Right) {
+      if (event.key.control) {
+        m_input.moveWordRight();
+      }
+      else {
+        moveCursorRight();
+      }
+    }
+    else if (event.key.code == sf::Keyboard::Home) {
+      moveCursorToBeginning();
+    }
+    else if (event.key.code == sf::Keyboard::End) {
+      moveCursorToEnd();
+    }
+    else if (event.key.code == sf::Keyboard::PageUp) {
+      scrollHistoryUp();
+    }
+    else if (event.key.code == sf::Keyboard::PageDown) {
+      scrollHistoryDown();
+    }
+    else if (event.key.code == sf::Keyboard::Return) {
+      enterInput();
+    }
+    else if (event.key.code == sf::Keyboard::A) {
+      if (event.key.control) {
+        moveCursorToBeginning();
+      }
+    }
+    else if (event.key.code == sf::Keyboard::C) {
+      if (event.key.control) {
+        cancelJobs(CommandParameterViews());
+      }
+    }
+    else if (event.key.code == sf::Keyboard::V) {
+      if (event.key.control) {
+        paste();
+      }
+    }
+    else if (event.key.code == sf::Keyboard::BackSpace) {
+      if (m_input.getCursor() > 0) {
+        // Deleting the last typed character widens the completion back to
+        // the parent prefix
+        if (m_input.getCursor() == m_input.size() &&
+            m_completionLength == m_input.size() &&
+            m_completionNode != CompletionTrie::NO_NODE) {
+          m_completionNode = m_completions.getParent(m_completionNode);
+          m_completionLength--;
+        }
+        else {
+          resetCompletion();
+        }
+
+        m_input.erase();
+      }
+    }
+    else if (event.key.code == sf::Keyboard::Delete) {
+      if (m_input.eraseForward()) {
+        resetCompletion();
+      }
+    }
+  }
+  else if (event.type == sf::Event::TextEntered) {
+    if (event.text.unicode > ASCII_BEGIN && event.text.unicode < ASCII_END) {
+      char c = static_cast<char>(event.text.unicode);
+
+      if (m_inputHistory.isSearching()) {
+        m_inputHistory.pushSearchCharacter(c);
+        m_isDirty = true;
+        return;
+      }
+
+      // Typing at the end of the input narrows the completion by one step
+      if (m_input.getCursor() == m_input.size() && m_completionLength == m_input.size()) {
+        m_completionNode = m_completions.step(m_completionNode, c);
+        m_completionLength++;
+      }
+      else {
+        resetCompletion();
+      }
+
+      m_input.insert(c);
+      m_isDirty = true;
+
+      // While searching the input is the pattern
+      if (m_isSearching) {
+        restartSearch();
+      }
+    }
+  }
+  else if (event.type == sf::Event::MouseWheelScrolled) {
+    if (event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) {
+      m_pendingScroll += event.mouseWheelScroll.delta * WHEEL_ROWS;
+    }
+  }
+  else if (event.type == sf::Event::Resized) {
+    onWindowResize(sf::Vector2u(event.size.width, event.size.height));
+  }
+}
+
+//=============================================================================
+//  void Console::update()
+//-----------------------------------------------------------------------------
+void Console::update()
+{
+#ifdef SFML_CONSOLE_PROFILER
+  // update() runs once per frame, so it also marks the frames
+  Profiler::instance().endFrame();
+  Profiler::instance().collect();
+#endif
+
+  SFML_CONSOLE_PROFILE_SCOPE("console.update");
+
+  drainPrintQueue();
+  notifyCvarChanges();
+  finishJobs();
+  runScripts();
+  m_inputHistory.poll();
+
+  if (m_search.update(m_outputHistory, SEARCH_LINES_PER_FRAME, SEARCH_ARCHIVED_LINES_PER_FRAME)) {
+    // Jump to the first match as soon as it is found
+    if (m_searchMatch == NO_MATCH && !m_search.getMatches().empty()) {
+      showMatch(0);
+    }
+
+    m_isDirty = true;
+  }
+
+  if (m_pendingScroll != 0) {
+    updateScroll();
+  }
+
+  // Move console in or out of window
+  switch (m_state) {
+    case State::OPENING: {
+      slideOpen();
+      break;
+    }
+    case State::CLOSING: {
+      slideClosed();
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+}
+
+//=============================================================================
+//  void Console::show()
+//-----------------------------------------------------------------------------
+void Console::show()
+{
+  m_isEnabled = true;
+  m_state = State::OPENING;
+}
+
+//=============================================================================
+//  void Console::hide()
+//-----------------------------------------------------------------------------
+void Console::hide()
+{
+  m_isEnabled = false;
+  m_state = State::CLOSING;
+}
+
+//=============================================================================
+//  void Console::toggle()
+//-----------------------------------------------------------------------------
+void Console::toggle()
+{
+  m_isEnabled = !m_isEnabled;
+
+  if (m_state == State::CLOSED || m_state == State::CLOSING) {
+    m_state = State::OPENING;
+  }
+  else {
+    m_state = State::CLOSING;
+  }
+}
+
+//=============================================================================
+//  void Console::isVisible()
+//-----------------------------------------------------------------------------
+bool
+Console::isVisible() const
+{
+  return m_isEnabled;
+}
+
+//=============================================================================
+//  void Console::prewarm()
+//-----------------------------------------------------------------------------
+void
+Console::prewarm()
+{
+  unsigned int characterSize = static_cast<unsigned int>(m_style.getFontSize());
+
+  for (uint32_t c = PREWARM_BEGIN; c <= PREWARM_END; ++c) {
+    m_font.getGlyph(c, characterSize, false);
+  }
+}
+
+//=============================================================================
+//  void Console::print()
+//-----------------------------------------------------------------------------
+void Console::print(const std::string& msg)
+{
+  print(std::string(), msg);
+}
+
+void Console::print(const std::string& source, const std::string& msg)
+{
+  if (std::this_thread::get_id() != m_ownerThread) {
+    m_printQueue.push(msg, source);
+    return;
+  }
+
+  // Keep lines queued by other threads ahead of this one
+  drainPrintQueue();
+
+  appendLimitedOutput(source, msg);
+}
+
+//=============================================================================
+//  void Console::setRateLimit()
+//-----------------------------------------------------------------------------
+void
+Console::setRateLimit(const std::string& source, double linesPerSecond, size_t burst)
+{
+  m_rateLimiter.setLimit(source, linesPerSecond, burst);
+}
+
+//=============================================================================
+//  void Console::appendLimitedOutput()
+//-----------------------------------------------------------------------------
+void
+Console::appendLimitedOutput(std::string_view source, const std::string& msg)
+{
+  if (m_rateLimiter.admit(source)) {
+    appendOutput(msg, m_style.getFontColor());
+  }
+}
+
+//=============================================================================
+//  void Console::appendOutput()
+//-----------------------------------------------------------------------------
+void
+Console::appendOutput(const std::string& msg, const sf::Color& color)
+{
+  size_t hash = std::hash<std::string>()(msg);
+
+  if (countRepeat(hash, msg, color)) {
+    return;
+  }
+
+  // Escapes are parsed once here, so the scrollback, the search and the log
+  // only ever see the text
+  m_markup.parse(msg, color);
+  const std::string& text = m_markup.getText();
+
+  m_outputHistory.push(text, color, m_markup.getSpans());
+  m_isDirty = true;
+
+  m_repeatLine = m_outputHistory.getFirstLineNumber() + m_outputHistory.size() - 1;
+  m_repeatHash = hash;
+  m_repeatMessage.assign(msg);
+  m_repeatColor = color;
+  m_nRepeats = 1;
+  m_repeatTextLength = text.size();
+
+  m_search.add(text);
+  m_search.discardBefore(m_outputHistory.getFirstLineNumber());
+
+  // Keep showing the same lines while scrolled back. Only near the top can
+  // a full scrollback dropping its oldest line leave the output short of
+  // rows, since every line has at least one.
+  if (m_scrollOffset > 0 || m_scrollRow > 0) {
+    m_scrollOffset++;
+
+    if (m_scrollOffset + m_visibleLines >= m_outputHistory.size()) {
+      clampScroll();
+    }
+  }
+
+  if (m_log) {
+    m_log->write(text);
+  }
+}
+
+//=============================================================================
+//  bool Console::countRepeat()
+//-----------------------------------------------------------------------------
+bool
+Console::countRepeat(size_t hash, const std::string& msg, const sf::Color& color)
+{
+  if (m_outputHistory.size() == 0 ||
+      m_outputHistory.getFirstLineNumber() + m_outputHistory.size() - 1 != m_repeatLine ||
+      hash != m_repeatHash || color != m_repeatColor || msg != m_repeatMessage) {
+    return false;
+  }
+
+  m_nRepeats++;
+
+  Line& line = m_outputHistory.back();
+  line.text.resize(m_repeatTextLength);
+  line.text += " x";
+  line.text += std::to_string(m_nRepeats);
+
+  // The count is in the line's own color, whatever color its text ends in
+  if (!line.spans.empty()) {
+    const TextSpan& last = line.spans.back();
+
+    if (last.begin < m_repeatTextLength && (last.color != color || last.isUnderlined)) {
+      line.spans.push_back(TextSpan{ static_cast<uint32_t>(m_repeatTextLength), color, false });
+    }
+  }
+
+  // The count may take the line onto another row
+  m_wraps.forget(m_repeatLine);
+  m_isDirty = true;
+
+  if (m_log) {
+    m_log->write(std::string_view(line.text.data(), m_repeatTextLength));
+  }
+
+  return true;
+}
+
+//=============================================================================
+//  void Console::drainPrintQueue()
+//-----------------------------------------------------------------------------
+void
+Console::drainPrintQueue()
+{
+  if (!m_printQueue.empty()) {
+    m_printQueue.drain([this] (const std::string& msg, const std::string& source) {
+      appendLimitedOutput(source, msg);
+    });
+  }
+
+  size_t nDropped = m_printQueue.takeDropped();
+
+  if (nDropped > 0) {
+    appendOutput(std::to_string(nDropped) + " messages dropped, print queue was full", m_style.getFontColor());
+  }
+
+  if (m_rateLimiter.hasDropped()) {
+    m_rateLimiter.takeDropped([this] (const std::string& source, size_t nDropped) {
+      std::string from = source.empty() ? "" : " from \"" + source + "\"";
+      appendOutput(std::to_string(nDropped) + " messages" + from + " dropped, over the rate limit",
+                   m_style.getFontColor());
+    });
+  }
+}
+
+//=============================================================================
+//  bool Console::registerCommand()
+//-----------------------------------------------------------------------------
+bool
+Console::registerCommand(const std::string& name, const Command& command)
+{
+  // Adapt the command to receive views, copying them only for this command
+  return registerCommand(name, [command] (const CommandParameterViews& views) {
+    CommandParameters params(views.begin(), views.end());
+    command(params);
+  });
+}
+
+bool
+Console::registerCommand(const std::string& name, const CommandView& command)
+{
+  if (m_cvars.find(name) != m_cvars.end())
+  {
+    print("Cannot register \"" + name + "\", a cvar is already registered with that name.");
+    return false;
+  }
+
+  if (!m_commands.insert(name, command))
+  {
+    print("Cannot register \"" + name + "\", a command is already registered with that name.");
+    return false;
+  }
+
+  m_completions.insert(name);
+
+  print("Registered console command \"" + name + "\"");
+
+  return true;
+}
+
+//=============================================================================
+//  bool Console::registerAsyncCommand()
+//-----------------------------------------------------------------------------
+bool
+Console::registerAsyncCommand(const std::string& name, const AsyncCommand& command)
+{
+  return registerCommand(name, [this, name, command] (const CommandParameterViews& params) {
+    startJob(name, params, command);
+  });
+}
+
+//=============================================================================
+//  bool Console::unregisterCommand()
+//-----------------------------------------------------------------------------
+bool
+Console::unregisterCommand(const std::string& name)
+{
+  if (!m_commands.erase(name))
+  {
+    print("Cannot unregister \"" + name + "\", a command with that name does not exist.");
+    return false;
+  }
+
+  m_completions.erase(name);
+
+  print("Unregistered console command \"" + name + "\"");
+
+  return true;
+}
+
+//=============================================================================
+//  bool Console::isCommand()
+//-----------------------------------------------------------------------------
+bool
+Console::isCommand(const std::string& name) const
+{
+  return static_cast<bool>(findCommand(name));
+}
+
+//=============================================================================
+//  CommandHandle Console::findCommand()
+//-----------------------------------------------------------------------------
+CommandHandle
+Console::findCommand(std::string_view name) const
+{
+  return m_commands.find(name);
+}
+
+//=============================================================================
+//  bool Console::invokeCommand()
+//-----------------------------------------------------------------------------
+bool
+Console::invokeCommand(CommandHandle handle, const CommandParameterViews& params)
+{
+  const CommandRegistry::Command* command = m_commands.get(handle);
+
+  if (command == nullptr) {
+    return false;
+  }
+
+  (*command)(params);
+
+  return true;
+}
+
+//=============================================================================
+//  Cvar* Console::registerCvar()
+//-----------------------------------------------------------------------------
+template <typename CvarType, typename ValueType>
+CvarType*
+Console::registerCvar(const std::string& name, ValueType value, const std::string& description)
+{
+  if (isNameTaken(name)) {
+    print("Cannot register cvar \"" + name + "\", the name is already in use.");
+    return nullptr;
+  }
+
+  CvarType* cvar = new CvarType(name, description, value, m_changedCvars);
+  m_cvars[name].reset(cvar);
+  m_completions.insert(name);
+
+  print("Registered console variable \"" + name + "\"");
+
+  return cvar;
+}
+
+IntCvar*
+Console::registerIntCvar(const std::string& name, int value, const std::string& description)
+{
+  return registerCvar<IntCvar>(name, value, description);
+}
+
+FloatCvar*
+Console::registerFloatCvar(const std::string& name, float value, const std::string& description)
+{
+  return registerCvar<FloatCvar>(name, value, description);
+}
+
+BoolCvar*
+Console::registerBoolCvar(const std::string& name, bool value, const std::string& description)
+{
+  return registerCvar<BoolCvar>(name, value, description);
+}
+
+StringCvar*
+Console::registerStringCvar(const std::string& name, std::string_view value, const std::string& description)
+{
+  return registerCvar<StringCvar>(name, value, description);
+}
+
+//=============================================================================
+//  CvarBase* Console::findCvar()
+//-----------------------------------------------------------------------------
+CvarBase*
+Console::findCvar(std::string_view name) const
+{
+  CvarMap::const_iterator it = m_cvars.find(name);
+  return it != m_cvars.end() ? it->second.get() : nullptr;
+}
+
+//=============================================================================
+//  bool Console::isNameTaken()
+//-----------------------------------------------------------------------------
+bool
+Console::isNameTaken(const std::string& name)
+{
+  return isCommand(name) || findCvar(name) != nullptr;
+}
+
+//=============================================================================
+//  const char* cvarTypeName()
+//-----------------------------------------------------------------------------
+static const char*
+cvarTypeName(CvarBase::Type type)
+{
+  switch (type) {
+    case CvarBase::Type::INT:
+      return "int";
+    case CvarBase::Type::FLOAT:
+      return "float";
+    case CvarBase::Type::BOOL:
+      return "bool";
+    default:
+      return "string";
+  }
+}
+
+//=============================================================================
+//  void Console::setCvar()
+//-----------------------------------------------------------------------------
+void
+Console::setCvar(CvarBase& cvar, const CommandParameterViews& params)
+{
+  if (params.size() == 0) {
+    print(cvar.getName() + " = " + cvar.toString());
+  }
+  else if (params.size() > 1) {
+    print("Usage: " + cvar.getName() + " <" + cvarTypeName(cvar.getType()) + ">");
+  }
+  else if (!cvar.setFromString(params.front())) {
+    print("Cannot set \"" + cvar.getName() + "\", expected a value of type " + cvarTypeName(cvar.getType()));
+  }
+}
+
+//=============================================================================
+//  void Console::notifyCvarChanges()
+//-----------------------------------------------------------------------------
+void
+Console::notifyCvarChanges()
+{
+  // A plain load keeps the usual case, nothing changed, from writing to the
+  // list every frame
+  if (m_changedCvars.load(std::memory_order_relaxed) == nullptr) {
+    return;
+  }
+
+  CvarBase* cvar = m_changedCvars.exchange(nullptr, std::memory_order_acquire);
+
+  while (cvar != nullptr) {
+    CvarBase* next = cvar->takeNextPending();
+    cvar->notifyCallback();
+    cvar = next;
+  }
+}
+
+//=============================================================================
+//  void Console::registerBuiltinCommands()
+//-----------------------------------------------------------------------------
+void
+Console::registerBuiltinCommands()
+{
+  // Registered without printing, so that a new console starts out empty
+  const std::pair<const char*, CommandView> builtins[] = {
+    { "commands", [this] (const CommandParameterViews&) { printCommands(); } },
+    { "cvars", [this] (const CommandParameterViews&) { printCvars(); } },
+    { "help", [this] (const CommandParameterViews& params) {
+        printHelp(params.empty() ? "" : std::string(params.front()));
+      }
+    },
+    { "cancel", [this] (const CommandParameterViews& params) { cancelJobs(params); } },
+    { "exec", [this] (const CommandParameterViews& params) {
+        if (params.size() != 1) {
+          print("Usage: exec <path>");
+          return;
+        }
+
+        exec(std::string(params.front()));
+      }
+    },
+    { "find", [this] (const CommandParameterViews& params) {
+        if (params.empty()) {
+          print("Usage: find <pattern>");
+          return;
+        }
+
+        std::string pattern(params.front());
+        for (size_t i = 1; i < params.size(); ++i) {
+          pattern.append(" ").append(params[i]);
+        }
+
+        beginSearch(pattern);
+      }
+    },
+    { "perf", [this] (const CommandParameterViews& params) {
+        if (!params.empty() && params.front() == "reset") {
+          Profiler::instance().reset();
+          return;
+        }
+
+        printPerf();
+      }
+    },
+  };
+
+  for (const auto& builtin : builtins) {
+    m_commands.insert(builtin.first, builtin.second);
+    m_completions.insert(builtin.first);
+  }
+
+#ifdef SFML_CONSOLE_PROFILER
+  m_perfOverlay = new BoolCvar("perf_overlay", "Show frame times over the game", false, m_changedCvars);
+  m_cvars["perf_overlay"].reset(m_perfOverlay);
+  m_completions.insert("perf_overlay");
+#endif
+}
+
+//=============================================================================
+//  void Console::startJob()
+//-----------------------------------------------------------------------------
+void
+Console::startJob(const std::string& name, const CommandParameterViews& params, const AsyncCommand& command)
+{
+  std::shared_ptr<AsyncJob> job = std::make_shared<AsyncJob>(*this, m_nextJobId++, name, params, command);
+  m_jobs.push_back(job);
+
+  print("[" + std::to_string(job->getId()) + "] " + name + " started");
+
+  m_workerPool.submit([job] {
+    job->run();
+  });
+
+  m_isDirty = true;
+}
+
+//=============================================================================
+//  void Console::cancelJobs()
+//-----------------------------------------------------------------------------
+void
+Console::cancelJobs(const CommandParameterViews& params)
+{
+  for (const std::shared_ptr<AsyncJob>& job : m_jobs) {
+    bool isSelected = params.empty();
+
+    for (std::string_view id : params) {
+      isSelected = isSelected || id == std::to_string(job->getId());
+    }
+
+    if (isSelected && !job->isCancelled()) {
+      job->cancel();
+      print("[" + std::to_string(job->getId()) + "] " + job->getName() + " cancelling");
+    }
+  }
+}
+
+//=============================================================================
+//  void Console::finishJobs()
+//-----------------------------------------------------------------------------
+void
+Console::finishJobs()
+{
+  if (m_jobs.empty()) {
+    return;
+  }
+
+  std::vector<std::shared_ptr<AsyncJob>>::iterator it = m_jobs.begin();
+
+  while (it != m_jobs.end()) {
+    const AsyncJob& job = **it;
+
+    if (!job.isFinished()) {
+      ++it;
+      continue;
+    }
+
+    // Show everything the job printed before reporting that it finished
+    drainPrintQueue();
+    print("[" + std::to_string(job.getId()) + "] " + job.getName() + (job.isCancelled() ? " cancelled" : " finished"));
+
+    it = m_jobs.erase(it);
+    m_isDirty = true;
+  }
+}
+
+//=============================================================================
+//  bool Console::exec()
+//-----------------------------------------------------------------------------
+bool
+Console::exec(const std::string& path)
+{
+  if (m_scripts.size() >= MAX_SCRIPT_DEPTH) {
+    print("Cannot exec \"" + path + "\", scripts are nested too deeply.");
+    return false;
+  }
+
+  std::unique_ptr<ScriptReader> script(new ScriptReader(path));
+
+  if (!script->isOpen()) {
+    print("Cannot exec \"" + path + "\", the file cannot be opened.");
+    return false;
+  }
+
+  m_scripts.push_back(std::move(script));
+
+  return true;
+}
+
+//=============================================================================
+//  bool Console::openLog()
+//-----------------------------------------------------------------------------
+bool
+Console::openLog(const std::string& path, size_t maxFileSize, size_t maxFiles)
+{
+  // Close the previous log first, so that reopening the same file works
+  m_log.reset();
+
+  std::unique_ptr<LogSink> log(new LogSink(path, maxFileSize, maxFiles));
+
+  if (!log->isOpen()) {
+    print("Cannot open log \"" + path + "\"");
+    return false;
+  }
+
+  m_log = std::move(log);
+
+  return true;
+}
+
+//=============================================================================
+//  void Console::closeLog()
+//-----------------------------------------------------------------------------
+void
+Console::closeLog()
+{
+  m_log.reset();
+}
+
+//=============================================================================
+//  bool Console::openHistory()
+//-----------------------------------------------------------------------------
+bool
+Console::openHistory(const std::string& path, size_t capacity)
+{
+  if (!m_inputHistory.open(path, capacity)) {
+    print("Cannot open history \"" + path + "\"");
+    return false;
+  }
+
+  m_inputHistoryPosition = INPUT_HISTORY_NO_POSITION;
+
+  return true;
+}
+
+//=============================================================================
+//  void Console::runScripts()
+//-----------------------------------------------------------------------------
+void
+Console::runScripts()
+{
+  size_t budget = m_style.getScriptLinesPerFrame();
+  std::string_view line;
+
+  while (budget > 0 && !m_scripts.empty()) {
+    if (!m_scripts.back()->nextLine(line)) {
+      m_scripts.pop_back();
+      continue;
+    }
+
+    // The line is tokenized before anything else runs, so it does not matter
+    // that the command may exec another script
+    executeLine(line);
+    budget--;
+  }
+}
+
+//=============================================================================
+//  void Console::beginSearch()
+//-----------------------------------------------------------------------------
+void
+Console::beginSearch(const std::string& pattern)
+{
+  if (!m_isSearching) {
+    // The input becomes the pattern until the search ends
+    m_searchSavedInput.assign(m_input.getText());
+    m_isSearching = true;
+  }
+
+  m_input.assign(pattern);
+  resetCompletion();
+  restartSearch();
+}
+
+//=============================================================================
+//  void Console::endSearch()
+//-----------------------------------------------------------------------------
+void
+Console::endSearch()
+{
+  m_search.stop();
+  m_searchMatch = NO_MATCH;
+  m_isSearching = false;
+
+  // Output stays scrolled to the last match
+  m_input.assign(m_searchSavedInput);
+  m_searchSavedInput.clear();
+  resetCompletion();
+  m_isDirty = true;
+}
+
+//=============================================================================
+//  void Console::restartSearch()
+//-----------------------------------------------------------------------------
+void
+Console::restartSearch()
+{
+  m_searchMatch = NO_MATCH;
+  m_search.start(m_input.getText());
+  m_isDirty = true;
+}
+
+//=============================================================================
+//  bool Console::handleSearchKey()
+//-----------------------------------------------------------------------------
+bool
+Console::handleSearchKey(const sf::Event::KeyEvent& key)
+{
+  const std::vector<size_t>& matches = m_search.getMatches();
+
+  switch (key.code) {
+    case sf::Keyboard::Escape: {
+      endSearch();
+      return true;
+    }
+    case sf::Keyboard::Up:
+    case sf::Keyboard::Return: {
+      // Matches are newest first, so older ones are further up
+      if (m_searchMatch != NO_MATCH && m_searchMatch + 1 < matches.size()) {
+        showMatch(m_searchMatch + 1);
+      }
+      return true;
+    }
+    case sf::Keyboard::Down: {
+      if (m_searchMatch != NO_MATCH && m_searchMatch > 0) {
+        showMatch(m_searchMatch - 1);
+      }
+      return true;
+    }
+    case sf::Keyboard::Tab: {
+      return true;
+    }
+    case sf::Keyboard::BackSpace: {
+      if (m_input.erase()) {
+        restartSearch();
+      }
+      return true;
+    }
+    case sf::Keyboard::Delete: {
+      if (m_input.eraseForward()) {
+        restartSearch();
+      }
+      return true;
+    }
+    case sf::Keyboard::V: {
+      // Pasting changes the pattern like typing does
+      if (key.control) {
+        paste();
+        restartSearch();
+      }
+      return key.control;
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
+//=============================================================================
+//  bool Console::handleHistorySearchKey()
+//-----------------------------------------------------------------------------
+bool
+Console::handleHistorySearchKey(const sf::Event::KeyEvent& key)
+{
+  switch (key.code) {
+    case sf::Keyboard::Escape: {
+      m_inputHistory.endSearch();
+      return true;
+    }
+    case sf::Keyboard::G: {
+      // Ctrl+G gives up the search as in bash, G alone is text
+      if (key.control) {
+        m_inputHistory.endSearch();
+      }
+      return key.control;
+    }
+    case sf::Keyboard::BackSpace: {
+      m_inputHistory.popSearchCharacter();
+      return true;
+    }
+    case sf::Keyboard::Return: {
+      acceptHistoryMatch();
+      enterInput();
+      return true;
+    }
+    case sf::Keyboard::R: {
+      // Ctrl+R looks further back
+      return !key.control;
+    }
+    case sf::Keyboard::Left:
+    case sf::Keyboard::Right:
+    case sf::Keyboard::Up:
+    case sf::Keyboard::Down:
+    case sf::Keyboard::Home:
+    case sf::Keyboard::End:
+    case sf::Keyboard::Tab: {
+      // Moving takes the match for editing, then moves as usual
+      acceptHistoryMatch();
+      return false;
+    }
+    default: {
+      // Other keys, including those typing the query, do nothing else
+      return true;
+    }
+  }
+}
+
+//=============================================================================
+//  void Console::acceptHistoryMatch()
+//-----------------------------------------------------------------------------
+void
+Console::acceptHistoryMatch()
+{
+  size_t match = m_inputHistory.getMatch();
+
+  if (match != InputHistory::NO_MATCH) {
+    m_input.assign(m_inputHistory.at(match));
+    resetCompletion();
+    m_inputHistoryPosition = INPUT_HISTORY_NO_POSITION;
+  }
+
+  m_inputHistory.endSearch();
+}
+
+//=============================================================================
+//  void Console::showMatch()
+//-----------------------------------------------------------------------------
+void
+Console::showMatch(size_t match)
+{
+  m_searchMatch = match;
+
+  size_t line = m_search.getMatches()[match];
+  if (line < m_outputHistory.getFirstLineNumber()) {
+    return;
+  }
+
+  // Scroll so that the match is about in the middle of the output
+  size_t index = line - m_outputHistory.getFirstLineNumber();
+  size_t nShown = m_visibleLines > 0 ? m_visibleLines - 1 : 0;
+  size_t end = index + 1 + nShown / 2;
+
+  stopScrolling();
+  m_scrollOffset = m_outputHistory.size() > end ? m_outputHistory.size() - end : 0;
+  m_scrollRow = 0;
+  clampScroll();
+  m_isDirty = true;
+}
+
+//=============================================================================
+//  void Console::printPerf()
+//-----------------------------------------------------------------------------
+void
+Console::printPerf()
+{
+#ifdef SFML_CONSOLE_PROFILER
+  const Profiler& profiler = Profiler::instance();
+  char row[128];
+
+  auto printRow = [&] (const std::string& name, const Profiler::History& history) {
+    std::snprintf(row, sizeof(row), "%-24s %6zu %8.3f %8.3f %8.3f %8.3f",
+                  name.c_str(), history.size(),
+                  history.percentile(0.5f), history.percentile(0.9f),
+                  history.percentile(0.99f), history.percentile(1.0f));
+    print(row);
+  };
+
+  std::snprintf(row, sizeof(row), "%-24s %6s %8s %8s %8s %8s",
+                "zone (ms)", "count", "p50", "p90", "p99", "max");
+  print(row);
+
+  printRow("frame", profiler.getFrames());
+
+  for (const auto& zone : profiler.getZones()) {
+    printRow(zone.first, zone.second);
+  }
+
+  size_t dropped = Profiler::instance().takeDropped();
+  if (dropped > 0) {
+    print(std::to_string(dropped) + " samples dropped");
+  }
+#else
+  print("The profiler is not compiled in, build with -DSFML_CONSOLE_PROFILER");
+#endif
+}
+
+//=============================================================================
+//  void Console::drawPerfOverlay()
+//-----------------------------------------------------------------------------
+void
+Console::drawPerfOverlay(sf::RenderTarget& target, sf::RenderStates states) const
+{
+  const Profiler& profiler = Profiler::instance();
+  const Profiler::History& frames = profiler.getFrames();
+
+  // One bar per frame, full height at two 60 Hz frames
+  const size_t nBars = 120;
+  const float barWidth = 2;
+  const float barHeight = 48;
+  const float fullScaleMs = 1000.f / 30;
+
+  const float margin = m_style.getMarginSize();
+  const float lineHeight = m_style.getFontSize();
+  const float width = nBars * barWidth + 2 * margin;
+  const float height = 2 * lineHeight + barHeight + 3 * margin;
+
+  sf::FloatRect panel(target.getSize().x - width - margin, target.getSize().y - height - margin, width, height);
+
+  auto zoneMean = [&profiler] (std::string_view name) {
+    Profiler::ZoneMap::const_iterator it = profiler.getZones().find(name);
+    return it != profiler.getZones().end() ? it->second.mean() : 0.f;
+  };
+
+  float frameMs = frames.size() > 0 ? frames.at(frames.size() - 1) : 0;
+  char text[64];
+
+  m_perfBatch.clear();
+  m_perfBatch.addRect(panel, sf::Color(0, 0, 0, 192));
+
+  std::snprintf(text, sizeof(text), "frame %.2f ms %.0f fps", frameMs, frameMs > 0 ? 1000 / frameMs : 0.f);
+  m_perfBatch.addText(text, panel.left + margin, panel.top + margin, sf::Color::White);
+
+  std::snprintf(text, sizeof(text), "update %.3f draw %.3f", zoneMean("console.update"), zoneMean("console.draw"));
+  m_perfBatch.addText(text, panel.left + margin, panel.top + margin + lineHeight, sf::Color::White);
+
+  // Most recent frame on the right
+  float bottom = panel.top + panel.height - margin;
+  size_t count = std::min(frames.size(), nBars);
+
+  for (size_t i = 0; i < count; ++i) {
+    float ms = frames.at(frames.size() - count + i);
+    float h = std::min(ms / fullScaleMs, 1.f) * barHeight;
+    sf::Color color = ms <= 1000.f / 60 ? sf::Color::Green : ms <= fullScaleMs ? sf::Color::Yellow : sf::Color::Red;
+
+    m_perfBatch.addRect(sf::FloatRect(panel.left + margin + (nBars - count + i) * barWidth, bottom - h, barWidth, h),
+                        color);
+  }
+
+  target.draw(m_perfBatch, states);
+}
+
+//=============================================================================
+//  void Console::printCommands()
+//-----------------------------------------------------------------------------
+void
+Console::printCommands()
+{
+  std::vector<std::string> names;
+  m_commands.forEachName([&names] (const std::string& name) {
+    names.push_back(name);
+  });
+
+  std::sort(names.begin(), names.end());
+
+  for (const std::string& name : names) {
+    print("  " + name);
+  }
+}
+
+//=============================================================================
+//  void Console::printCvars()
+//-----------------------------------------------------------------------------
+void
+Console::printCvars()
+{
+  for (const CvarMap::value_type& entry : m_cvars) {
+    const CvarBase& cvar = *entry.second;
+    print("  " + cvar.getName() + " = " + cvar.toString());
+  }
+}
+
+//=============================================================================
+//  void Console::printHelp()
+//-----------------------------------------------------------------------------
+void
+Console::printHelp(std::string name)
+{
+  if (name.empty()) {
+    print("Enter a command followed by its parameters, or a cvar followed by a new value.");
+    print("\"commands\" lists commands, \"cvars\" lists cvars and \"help <name>\" describes one.");
+    return;
+  }
+
+  if (const CvarBase* cvar = findCvar(name)) {
+    print(cvar->getName() + " (" + cvarTypeName(cvar->getType()) + ") = " + cvar->toString());
+
+    if (!cvar->getDescription().empty()) {
+      print("  " + cvar->getDescription());
+    }
+  }
+  else if (isCommand(name)) {
+    print(name + " is a console command");
+  }
+  else {
+    print("No command or cvar named \"" + name + "\"");
+  }
+}
+
+//=============================================================================
+//  void Console::draw()
+//-----------------------------------------------------------------------------
+void
+Console::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+  SFML_CONSOLE_PROFILE_SCOPE("console.draw");
+
+  const bool isClosed = (m_state == State::CLOSED);
+  bool isOverlayShown = false;
+
+#ifdef SFML_CONSOLE_PROFILER
+  isOverlayShown = m_perfOverlay->get();
+#endif
+
+  // Nothing is on screen while closed. Whatever changed in the meantime is
+  // laid out once, on the first frame the console opens again.
+  if (isClosed && !isOverlayShown) {
+    return;
+  }
+
+  sf::View view(sf::FloatRect(sf::Vector2f(0, 0),
+                sf::Vector2f(target.getSize().x, target.getSize().y)));
+  target.setView(view);
+
+  if (!isClosed && m_isDirty) {
+    layout();
+  }
+
+  if (!isClosed) {
+    sf::RenderStates consoleStates = states;
+    consoleStates.transform.translate(0, m_slideOffset);
+    target.draw(m_batch, consoleStates);
+  }
+
+  // Over the console, which would otherwise cover it while open, and not
+  // moved by the slide
+#ifdef SFML_CONSOLE_PROFILER
+  if (isOverlayShown) {
+    drawPerfOverlay(target, states);
+  }
+#endif
+
+  target.setView(target.getDefaultView());
 }
 
 //=============================================================================
-//  void Console::handleEvent()
+//  void Console::layout()
 //-----------------------------------------------------------------------------
 void
-Console::handleEvent(const sf::Event& event)
+Console::layout() const
 {
-  if (!m_isEnabled) {
-    return;
-  }
+  SFML_CONSOLE_PROFILE_SCOPE("console.layout");
 
-  if (event.type == sf::Event::KeyPressed) {
-    if (event.key.code == sf::Keyboard::Up) {
-      scrollInputUp();
-      moveCursorToEnd();
+  m_batch.clear();
+
+  m_batch.addRect(m_border, m_style.getBorderColor());
+  m_batch.addRect(m_background, m_style.getBackgroundColor());
+
+  std::string prompt(1, m_isSearching ? SEARCH_PROMPT_CHARACTER : m_style.getPromptCharacter());
+  m_batch.addText(prompt, m_promptPosition.x, m_promptPosition.y, m_style.getFontColor());
+
+  sf::Vector2f pos = sf::Vector2f(m_border.left + 2 * m_style.getMarginSize(), m_border.top + 2 * m_style.getMarginSize());
+
+  // The last row is taken by the input
+  size_t nRows = m_visibleLines > 0 ? m_visibleLines - 1 : 0;
+
+  if (m_scrollPixel > 0) {
+    // Start from the row below the scroll position, which is partly shown
+    // at the bottom, and cut the rows at the edges of the output area
+    size_t scrollOffset = m_scrollOffset;
+    size_t scrollRow = m_scrollRow;
+
+    if (scrollRow > 0) {
+      scrollRow--;
     }
-    else if (event.key.code == sf::Keyboard::Down) {
-      scrollInputDown();
-      moveCursorToEnd();
+    else {
+      scrollOffset--;
+      scrollRow = getRowCount(m_outputHistory.size() - 1 - scrollOffset) - 1;
     }
-    else if (event.key.code == sf::Keyboard::Left) {
-      moveCursorLeft();
+
+    collectVisibleRows(nRows + 1, scrollOffset, scrollRow);
+
+    m_batch.setClip(pos.y, pos.y + nRows * m_style.getFontSize());
+    pos.y -= m_scrollPixel;
+  }
+  else {
+    collectVisibleRows(nRows, m_scrollOffset, m_scrollRow);
+  }
+
+  size_t highlighted = NO_MATCH;
+  if (m_isSearching && m_searchMatch != NO_MATCH) {
+    size_t match = m_search.getMatches()[m_searchMatch];
+    if (match >= m_outputHistory.getFirstLineNumber()) {
+      highlighted = match - m_outputHistory.getFirstLineNumber();
     }
-    else if (event.key.code == sf::Keyboard::Right) {
-      moveCursorRight();
+  }
+
+  size_t lineIndex = NO_MATCH;
+  LineView line;
+
+  for (const VisibleRow& row : m_visibleRows) {
+    if (row.line == highlighted) {
+      m_batch.addRect(sf::FloatRect(m_background.left, pos.y, m_background.width, m_style.getFontSize()),
+                      MATCH_HIGHLIGHT_COLOR);
     }
-    else if (event.key.code == sf::Keyboard::PageUp) {
-      scrollHistoryUp();
+
+    // Archived lines are paged in from disk here, only while they are shown
+    if (row.line != lineIndex) {
+      lineIndex = row.line;
+      line = m_outputHistory.at(lineIndex);
     }
-    else if (event.key.code == sf::Keyboard::PageDown) {
-      scrollHistoryDown();
+
+    if (line.nSpans == 0) {
+      m_batch.addText(line.text.data() + row.begin, line.text.data() + row.end, pos.x, pos.y, line.color);
     }
-    else if (event.key.code == sf::Keyboard::Return) {
-      enterInput();
+    else {
+      m_batch.addSpans(line.text, row.begin, row.end, line.spans, line.nSpans, pos.x, pos.y);
     }
-    else if (event.key.code == sf::Keyboard::A) {
-      if (sf::Keyboard::isKeyPressed(sf::Keyboard::LControl)) {
-        moveCursorToBeginning();
-      }
+
+    pos.y += m_style.getFontSize();
+  }
+
+  m_batch.resetClip();
+
+  // Show the search and how many asynchronous commands are still running in
+  // the top right
+  std::string status;
+
+  if (m_isSearching) {
+    size_t nMatches = m_search.getMatches().size();
+
+    if (nMatches == 0) {
+      status = m_search.isRunning() ? "[searching]" : "[no matches]";
     }
-    else if (event.key.code == sf::Keyboard::BackSpace) {
-      if (m_currentInput.length() > 0 && m_cursorPosition > 0) {
-        m_currentInput.erase(m_cursorPosition - 1, 1);
-        moveCursorLeft();
-      }
+    else {
+      status = "[" + std::to_string(m_searchMatch + 1) + "/" + std::to_string(nMatches) +
+               (m_search.isRunning() ? "+]" : "]");
     }
   }
-  else if (event.type == sf::Event::TextEntered) {
-    if (event.text.unicode > ASCII_BEGIN && event.text.unicode < ASCII_END) {
-      m_currentInput.insert(m_cursorPosition, 1, static_cast<char>(event.text.unicode));
-      moveCursorRight();
+
+  if (!m_jobs.empty()) {
+    status += "[" + std::to_string(m_jobs.size()) + " running]";
+  }
+
+  if (!status.empty()) {
+    float right = m_background.left + m_background.width - m_style.getMarginSize();
+
+    m_batch.addText(status,
+                    right - m_batch.measure(status, status.size()),
+                    m_border.top + 2 * m_style.getMarginSize(),
+                    m_style.getFontColor());
+  }
+
+  std::string cursor(1, CURSOR_CHARACTER);
+
+  // A reverse search shows the query and its match in place of the input
+  if (m_inputHistory.isSearching()) {
+    std::string historySearch;
+    size_t match = m_inputHistory.getMatch();
+    bool isFailed = match == InputHistory::NO_MATCH && !m_inputHistory.getQuery().empty();
+
+    historySearch = isFailed ? "(failed reverse-i-search)'" : "(reverse-i-search)'";
+    historySearch += m_inputHistory.getQuery();
+    historySearch += "': ";
+
+    if (match != InputHistory::NO_MATCH) {
+      historySearch += m_inputHistory.at(match);
     }
+
+    float end = m_batch.addText(historySearch, m_inputPosition.x, m_inputPosition.y, m_style.getFontColor());
+    m_batch.addText(cursor, end, m_inputPosition.y, m_style.getFontColor());
   }
-  else if (event.type == sf::Event::Resized) {
-    onWindowResize(sf::Vector2u(event.size.width, event.size.height));
+  else {
+    layoutInput(cursor);
   }
+
+  m_isDirty = false;
 }
 
 //=============================================================================
-//  void Console::update()
+//  void Console::layoutInput()
 //-----------------------------------------------------------------------------
-void Console::update()
+void
+Console::layoutInput(const std::string& cursor) const
 {
+  float width = m_background.left + m_background.width - m_style.getMarginSize() - m_inputPosition.x;
+  float cursorX = m_input.getX(m_input.getCursor());
+  float cursorWidth = m_batch.measure(cursor, cursor.size());
+
+  // Scroll no further than needed to keep the cursor in view, and no further
+  // than the end of the input
+  m_inputScroll = std::min(m_inputScroll, std::max(0.0f, m_input.getWidth() + cursorWidth - width));
+  m_inputScroll = std::max(m_inputScroll, cursorX + cursorWidth - width);
+  m_inputScroll = std::min(m_inputScroll, cursorX);
+
+  // Only the characters that fit are laid out, however long the input is
+  float right = m_inputScroll + width;
+  size_t begin = m_input.findIndex(m_inputScroll);
+  size_t end = m_input.findIndex(right);
+
+  if (end > begin && m_input.getX(end) > right) {
+    end--;
+  }
+
+  std::string visible;
+  m_input.copy(begin, end, visible);
+
+  uint32_t previous = begin > 0 ? static_cast<unsigned char>(m_input.at(begin - 1)) : 0;
 
-  m_sfCurrentInput.setString(m_currentInput);
+  m_batch.addText(visible.data(), visible.data() + visible.size(),
+                  m_inputPosition.x + m_input.getX(begin) - m_inputScroll,
+                  m_inputPosition.y,
+                  m_style.getFontColor(),
+                  previous);
 
-  // Calculate cursor offset and apply it to string
-  m_cursorMask = "";
+  m_batch.addText(cursor, m_inputPosition.x + cursorX - m_inputScroll, m_inputPosition.y, m_style.getFontColor());
+}
+
+//=============================================================================
+//  void Console::collectVisibleRows()
+//-----------------------------------------------------------------------------
+void
+Console::collectVisibleRows(size_t nRows, size_t scrollOffset, size_t scrollRow) const
+{
+  m_visibleRows.clear();
 
-  for (int i = 0; i < m_cursorPosition; i++) {
-    m_cursorMask += " ";
+  if (m_outputHistory.size() == 0) {
+    return;
   }
 
-  m_cursorMask += CURSOR_CHARACTER;
+  size_t index = m_outputHistory.size() - 1 - std::min(scrollOffset, m_outputHistory.size() - 1);
+  size_t nHidden = scrollRow;
 
-  m_sfCursorMask.setString(m_cursorMask);
+  // From the bottom up, newest row first
+  while (m_visibleRows.size() < nRows) {
+    LineView line = m_outputHistory.at(index);
+    const WrapCache::Breaks& breaks = m_wraps.getBreaks(m_outputHistory.getFirstLineNumber() + index, line.text);
 
-  // Move console in or out of window
-  switch (m_state) {
-    case State::OPENING: {
-      slideOpen();
-      break;
-    }
-    case State::CLOSING: {
-      slideClosed();
-      break;
+    size_t row = breaks.size() + 1 - std::min(nHidden, breaks.size());
+
+    while (row > 0 && m_visibleRows.size() < nRows) {
+      row--;
+
+      uint32_t begin = row > 0 ? breaks[row - 1] : 0;
+      uint32_t end = row < breaks.size() ? breaks[row] : static_cast<uint32_t>(line.text.size());
+
+      m_visibleRows.push_back(VisibleRow{ index, begin, end });
     }
-    default: {
+
+    if (index == 0) {
       break;
     }
+
+    index--;
+    nHidden = 0;
   }
+
+  std::reverse(m_visibleRows.begin(), m_visibleRows.end());
 }
 
 //=============================================================================
-//  void Console::show()
+//  void Console::insert()
 //-----------------------------------------------------------------------------
-void Console::show()
+void Console::insert(std::string text)
 {
-  m_isEnabled = true;
-  m_state = State::OPENING;
+  m_input.moveToEnd();
+  m_input.insert(text);
+  m_isDirty = true;
 }
 
 //=============================================================================
-//  void Console::hide()
+//  void Console::paste()
 //-----------------------------------------------------------------------------
-void Console::hide()
+void
+Console::paste()
 {
-  m_isEnabled = false;
-  m_state = State::CLOSING;
+  sf::String clipboard = sf::Clipboard::getString();
+
+  // Only what could have been typed is kept, so a pasted multi-line text
+  // becomes a single line
+  std::string text;
+  text.reserve(clipboard.getSize());
+
+  for (sf::Uint32 c : clipboard) {
+    if (c > ASCII_BEGIN && c < ASCII_END) {
+      text.push_back(static_cast<char>(c));
+    }
+    else if (c == '\n' || c == '\t') {
+      text.push_back(' ');
+    }
+  }
+
+  m_input.insert(text);
+  resetCompletion();
+  m_isDirty = true;
 }
 
 //=============================================================================
-//  void Console::toggle()
+//  void Console::complete()
 //-----------------------------------------------------------------------------
-void Console::toggle()
+void
+Console::complete()
 {
-  m_isEnabled = !m_isEnabled;
+  // Only the command name at the start of the input is completed
+  if (m_input.getCursor() != m_input.size()) {
+    return;
+  }
 
-  if (m_state == State::CLOSED || m_state == State::CLOSING) {
-    m_state = State::OPENING;
+  std::string_view input = m_input.getText();
+
+  if (input.find_first_of(" \t") != std::string_view::npos) {
+    return;
+  }
+
+  // Catch up with characters that were not typed one at a time
+  while (m_completionLength < input.size()) {
+    m_completionNode = m_completions.step(m_completionNode, input[m_completionLength]);
+    m_completionLength++;
+  }
+
+  size_t nCandidates = m_completions.getCount(m_completionNode);
+
+  if (nCandidates == 0) {
+    return;
+  }
+
+  // Complete as far as all candidates agree
+  std::string extension;
+  m_completionNode = m_completions.extendCommonPrefix(m_completionNode, extension);
+  m_input.insert(extension);
+  m_completionLength = m_input.size();
+
+  if (!extension.empty()) {
+    return;
+  }
+  else if (nCandidates == 1) {
+    // The name is complete, move on to its parameters
+    m_input.insert(' ');
+    resetCompletion();
   }
   else {
-    m_state = State::CLOSING;
+    std::vector<std::string> names;
+    m_completions.collect(m_completionNode, MAX_COMPLETIONS_LISTED, names);
+
+    for (const std::string& name : names) {
+      print("  " + name);
+    }
+
+    if (nCandidates > names.size()) {
+      print("  ... and " + std::to_string(nCandidates - names.size()) + " more");
+    }
   }
 }
 
 //=============================================================================
-//  void Console::isVisible()
+//  void Console::resetCompletion()
 //-----------------------------------------------------------------------------
-bool
-Console::isVisible() const
+void
+Console::resetCompletion()
 {
-  return m_isEnabled;
+  m_completionNode = CompletionTrie::ROOT;
+  m_completionLength = 0;
 }
 
 //=============================================================================
-//  void Console::print()
+//  void Console::scrollHistoryUp()
 //-----------------------------------------------------------------------------
-void Console::print(const std::string& msg)
+void Console::scrollHistoryUp()
 {
-  sf::Text text;
-  text.setString(msg);
-  text.setFont(m_font);
-  text.setColor(sf::Color::White);
+  size_t nShown = m_visibleLines > 0 ? m_visibleLines - 1 : 0;
 
-  m_outputHistory.push_back(text);
+  // Keep one row of the previous page in view
+  m_pendingScroll += std::max<size_t>(nShown, 2) - 1;
 }
 
 //=============================================================================
-//  bool Console::registerCommand()
+//  void Console::scrollHistoryDown()
 //-----------------------------------------------------------------------------
-bool
-Console::registerCommand(const std::string& name, const Command& command)
+void Console::scrollHistoryDown()
 {
-  if (findCommand(name) != m_commands.end())
-  {
-    print("Cannot register \"" + name + "\", a command is already registered with that name.");
-    return false;
-  }
+  size_t nShown = m_visibleLines > 0 ? m_visibleLines - 1 : 0;
 
-  m_commands[name] = command;
-  print("Registered console command \"" + name + "\"");
-
-  return true;
+  m_pendingScroll -= std::max<size_t>(nShown, 2) - 1;
 }
 
 //=============================================================================
-//  bool Console::unregisterCommand()
+//  void Console::updateScroll()
 //-----------------------------------------------------------------------------
-bool
-Console::unregisterCommand(const std::string& name)
+void
+Console::updateScroll()
 {
-  CommandMap::const_iterator it = findCommand(name);
+  float rows = m_pendingScroll;
 
-  if (it == m_commands.end())
-  {
-    print("Cannot unregister \"" + name + "\", a command with that name does not exist.");
-    return false;
+  if (std::fabs(rows) > SCROLL_SNAP_ROWS) {
+    rows *= SCROLL_SMOOTHING;
   }
 
-  m_commands.erase(it);
-  print("Unregistered console command \"" + name + "\"");
-
-  return true;
+  m_pendingScroll -= rows;
+  scrollPixels(rows * m_style.getFontSize());
 }
 
 //=============================================================================
-//  bool Console::isCommand()
+//  void Console::scrollPixels()
 //-----------------------------------------------------------------------------
-bool
-Console::isCommand(const std::string& name) const
+void
+Console::scrollPixels(float pixels)
 {
-  return findCommand(name) != m_commands.end();
+  const float rowHeight = m_style.getFontSize();
+
+  m_scrollPixel -= pixels;
+
+  while (m_scrollPixel < 0) {
+    size_t scrollOffset = m_scrollOffset;
+    size_t scrollRow = m_scrollRow;
+
+    scrollRowsUp(1);
+
+    // The oldest row is already at the top
+    if (m_scrollOffset == scrollOffset && m_scrollRow == scrollRow) {
+      m_scrollPixel = 0;
+      m_pendingScroll = 0;
+      break;
+    }
+
+    m_scrollPixel += rowHeight;
+  }
+
+  while (m_scrollPixel >= rowHeight && (m_scrollOffset > 0 || m_scrollRow > 0)) {
+    scrollRowsDown(1);
+    m_scrollPixel -= rowHeight;
+  }
+
+  // There is nothing below the newest row to show
+  if (m_scrollOffset == 0 && m_scrollRow == 0 && m_scrollPixel > 0) {
+    m_scrollPixel = 0;
+    m_pendingScroll = std::max(m_pendingScroll, 0.0f);
+  }
+
+  m_isDirty = true;
 }
 
 //=============================================================================
-//  const_iterator Console::findCommand()
+//  void Console::stopScrolling()
 //-----------------------------------------------------------------------------
-Console::CommandMap::const_iterator
-Console::findCommand(const std::string& name) const
+void
+Console::stopScrolling()
 {
-  return m_commands.find(name);
+  m_scrollPixel = 0;
+  m_pendingScroll = 0;
 }
 
 //=============================================================================
-//  void Console::draw()
+//  void Console::scrollRowsUp()
 //-----------------------------------------------------------------------------
 void
-Console::draw(sf::RenderTarget& target, sf::RenderStates states) const
+Console::scrollRowsUp(size_t nRows)
 {
-  sf::View view(sf::FloatRect(sf::Vector2f(0, 0),
-                sf::Vector2f(target.getSize().x, target.getSize().y)));
-  target.setView(view);
-
-  target.draw(m_border);
-  target.draw(m_background);
-  target.draw(m_prompt);
-
-  sf::Vector2f borderPos = m_border.getPosition();
-  sf::Vector2f pos = sf::Vector2f(borderPos.x + 2 * m_style.getMarginSize(), borderPos.y + 2 * m_style.getMarginSize());
-
-  int startPos = m_outputHistory.size() - m_visibleLines + 1;  // The 1 accounts for the current input
-
-  if (startPos < 0) {
-    startPos = 0;
+  if (m_outputHistory.size() == 0) {
+    return;
   }
 
-  int nLines = 0;
-  for (int i = startPos; i < m_outputHistory.size() && nLines < m_visibleLines; ++i, ++nLines) {
-    sf::Text text = m_outputHistory.at(i);
-    text.setPosition(pos.x, pos.y);
-    text.setCharacterSize(m_style.getFontSize());
-    target.draw(text);
+  for (; nRows > 0; --nRows) {
+    size_t index = m_outputHistory.size() - 1 - m_scrollOffset;
 
-    pos.y += m_style.getFontSize();
+    if (m_scrollRow + 1 < getRowCount(index)) {
+      m_scrollRow++;
+    }
+    else if (index > 0) {
+      m_scrollOffset++;
+      m_scrollRow = 0;
+    }
+    else {
+      break;
+    }
   }
 
-  target.draw(m_sfCurrentInput);
-  target.draw(m_sfCursorMask);
-
-  target.setView(target.getDefaultView());
+  clampScroll();
+  m_isDirty = true;
 }
 
 //=============================================================================
-//  void Console::insert()
+//  void Console::scrollRowsDown()
 //-----------------------------------------------------------------------------
-void Console::insert(std::string text)
+void
+Console::scrollRowsDown(size_t nRows)
 {
-  m_currentInput.append(text);
-  moveCursorToEnd();
+  for (; nRows > 0; --nRows) {
+    if (m_scrollRow > 0) {
+      m_scrollRow--;
+    }
+    else if (m_scrollOffset > 0) {
+      m_scrollOffset--;
+      m_scrollRow = getRowCount(m_outputHistory.size() - 1 - m_scrollOffset) - 1;
+    }
+    else {
+      break;
+    }
+  }
+
+  m_isDirty = true;
 }
 
 //=============================================================================
-//  void Console::scrollHistoryUp()
+//  void Console::clampScroll()
 //-----------------------------------------------------------------------------
-void Console::scrollHistoryUp()
+void
+Console::clampScroll()
 {
+  if (m_outputHistory.size() == 0) {
+    m_scrollOffset = 0;
+    m_scrollRow = 0;
+    m_scrollPixel = 0;
+    return;
+  }
+
+  if (m_scrollOffset >= m_outputHistory.size()) {
+    m_scrollOffset = m_outputHistory.size() - 1;
+    m_scrollRow = 0;
+  }
+
+  size_t index = m_outputHistory.size() - 1 - m_scrollOffset;
+  m_scrollRow = std::min(m_scrollRow, getRowCount(index) - 1);
+
+  // Count the rows from the bottom of the output up to the oldest one,
+  // stopping once there are enough to fill the output
+  size_t nShown = m_visibleLines > 0 ? m_visibleLines - 1 : 0;
+  size_t nRows = getRowCount(index) - m_scrollRow;
+
+  while (nRows < nShown && index > 0) {
+    index--;
+    nRows += getRowCount(index);
+  }
+
+  if (nRows < nShown) {
+    scrollRowsDown(nShown - nRows);
+  }
 
+  // There is no row below the newest one to shift into view
+  if (m_scrollOffset == 0 && m_scrollRow == 0) {
+    m_scrollPixel = 0;
+  }
 }
 
 //=============================================================================
-//  void Console::scrollHistoryDown()
+//  size_t Console::getRowCount()
 //-----------------------------------------------------------------------------
-void Console::scrollHistoryDown()
+size_t
+Console::getRowCount(size_t index) const
 {
-
+  return m_wraps.getRowCount(m_outputHistory.getFirstLineNumber() + index, m_outputHistory.at(index).text);
 }
 
 //=============================================================================
@@ -346,7 +1919,7 @@ void Console::scrollInputUp()
   }
 
   if (m_inputHistoryPosition == INPUT_HISTORY_NO_POSITION) {
-    m_tempInput = m_currentInput;
+    m_tempInput.assign(m_input.getText());
     m_inputHistoryPosition = (int)m_inputHistory.size() - 1;
   }
   else {
@@ -357,7 +1930,7 @@ void Console::scrollInputUp()
     m_inputHistoryPosition = 0;
   }
 
-  m_currentInput = m_inputHistory.at(m_inputHistoryPosition);
+  m_input.assign(m_inputHistory.at(m_inputHistoryPosition));
 }
 
 //=============================================================================
@@ -371,13 +1944,13 @@ void Console::scrollInputDown()
 
   // If position is bottom of queue
   if (m_inputHistoryPosition == m_inputHistory.size() - 1) {
-    m_currentInput = m_tempInput;
+    m_input.assign(m_tempInput);
     m_inputHistoryPosition = INPUT_HISTORY_NO_POSITION;
     return;
   }
   else {
     m_inputHistoryPosition++;
-    m_currentInput = m_inputHistory.at(m_inputHistoryPosition);
+    m_input.assign(m_inputHistory.at(m_inputHistoryPosition));
   }
 }
 
@@ -386,9 +1959,7 @@ void Console::scrollInputDown()
 //-----------------------------------------------------------------------------
 void Console::moveCursorLeft()
 {
-  if (m_cursorPosition > 0) {
-    m_cursorPosition--;
-  }
+  m_input.moveLeft();
 }
 
 //=============================================================================
@@ -396,11 +1967,7 @@ void Console::moveCursorLeft()
 //-----------------------------------------------------------------------------
 void Console::moveCursorRight()
 {
-  m_cursorPosition++;
-
-  if (m_cursorPosition > m_currentInput.size()) {
-    moveCursorToEnd();
-  }
+  m_input.moveRight();
 }
 
 //=============================================================================
@@ -408,7 +1975,7 @@ void Console::moveCursorRight()
 //-----------------------------------------------------------------------------
 void Console::moveCursorToBeginning()
 {
-  m_cursorPosition = 0;
+  m_input.moveToBeginning();
 }
 
 //=============================================================================
@@ -416,7 +1983,7 @@ void Console::moveCursorToBeginning()
 //-----------------------------------------------------------------------------
 void Console::moveCursorToEnd()
 {
-  m_cursorPosition = m_currentInput.size();
+  m_input.moveToEnd();
 }
 
 //=============================================================================
@@ -425,23 +1992,13 @@ void Console::moveCursorToEnd()
 void Console::clearHistory()
 {
   m_outputHistory.clear();
-}
-
-//=============================================================================
-//  Tokens tokenize()
-//-----------------------------------------------------------------------------
-ConsoleApi::CommandParameters
-tokenize(const std::string& input)
-{
-  ConsoleApi::CommandParameters tokens;
-
-  std::regex re("(\".*\")|(\'.*\')|([^\\s]?[^\\s]+)");
+  stopScrolling();
+  m_scrollOffset = 0;
+  m_scrollRow = 0;
 
-  std::copy(std::sregex_token_iterator(input.begin(), input.end(), re),
-            std::sregex_token_iterator(),
-            std::back_inserter(tokens));
-
-  return tokens;
+  m_search.clear(m_outputHistory.getFirstLineNumber());
+  m_searchMatch = NO_MATCH;
+  m_isDirty = true;
 }
 
 //=============================================================================
@@ -450,39 +2007,70 @@ tokenize(const std::string& input)
 void
 Console::enterInput()
 {
-  print(m_currentInput);
+  // Keep a copy of the input to execute it. m_tempInput is not used for
+  // this, it holds the unsent input while browsing the history.
+  std::string line(m_input.getText());
+
+  // The echo is neither rate limited nor counted as a repeat, of the line
+  // before it or by the output after it. Lines queued by other threads stay
+  // ahead of it.
+  drainPrintQueue();
+  m_repeatLine = NO_MATCH;
+  appendOutput(line, m_style.getFontColor());
+  m_repeatLine = NO_MATCH;
 
   // Now that input has been entered, add it to history
-  m_inputHistory.push_back(m_currentInput);
+  m_inputHistory.push(line);
 
   // Reset the history position to scroll to newest input
   m_inputHistoryPosition = INPUT_HISTORY_NO_POSITION;
 
-  // Tokenize input
-  ConsoleApi::CommandParameters params = tokenize(m_currentInput);
+  // Show the output of what was entered
+  stopScrolling();
+  m_scrollOffset = 0;
+  m_scrollRow = 0;
 
   // Is there any input?
-  if (params.size() == 0) {
+  if (line.find_first_not_of(" \t") == std::string::npos) {
     return;
   }
 
   // Reset prompt
-  m_currentInput.clear();
-  moveCursorToBeginning();
+  m_input.clear();
+  resetCompletion();
+
+  executeLine(line);
+}
+
+//=============================================================================
+//  void Console::executeLine()
+//-----------------------------------------------------------------------------
+void
+Console::executeLine(std::string_view line)
+{
+  const Tokenizer::Tokens& tokens = m_tokenizer.tokenize(line);
+
+  if (tokens.size() == 0) {
+    return;
+  }
 
-  // Try to find a command that matches the first parameter
-  const std::string& cmd = params.front();
-  CommandMap::const_iterator it = findCommand(cmd);
+  // Try to find a command that matches the first token
+  std::string_view cmd = tokens.front();
+  CommandHandle handle = findCommand(cmd);
 
-  if (it != m_commands.end()) {
-    // Remove command name from parameter list
-    params.erase(params.begin());
+  if (handle) {
+    // The remaining tokens are the command's parameters
+    m_parameters.assign(tokens.begin() + 1, tokens.end());
 
     // Execute command
-    it->second(params);
+    invokeCommand(handle, m_parameters);
+  }
+  else if (CvarBase* cvar = findCvar(cmd)) {
+    m_parameters.assign(tokens.begin() + 1, tokens.end());
+    setCvar(*cvar, m_parameters);
   }
   else {
-    print("Unknown command \"" + cmd + "\"");
+    print("Unknown command \"" + std::string(cmd) + "\"");
   }
 }
 
@@ -492,14 +2080,11 @@ Console::enterInput()
 void
 Console::slideClosed()
 {
-  m_border.move(0, -m_slideSpeed);
-  m_background.move(0, -m_slideSpeed);
-  m_sfCurrentInput.move(0, -m_slideSpeed);
-  m_sfCursorMask.move(0, -m_slideSpeed);
-  m_prompt.move(0, -m_slideSpeed);
+  m_slideOffset -= m_slideSpeed;
 
   // Is console fully closed?
-  if (m_border.getPosition().y <= -m_border.getSize().y) {
+  if (m_slideOffset <= -m_border.height) {
+    m_slideOffset = -m_border.height;
     setClosed();
   }
 }
@@ -510,14 +2095,11 @@ Console::slideClosed()
 void
 Console::slideOpen()
 {
-  m_border.move(0, m_slideSpeed);
-  m_background.move(0, m_slideSpeed);
-  m_sfCurrentInput.move(0, m_slideSpeed);
-  m_sfCursorMask.move(0, m_slideSpeed);
-  m_prompt.move(0, m_slideSpeed);
+  m_slideOffset += m_slideSpeed;
 
   // Is console fully open?
-  if (m_border.getPosition().y >= 0) {
+  if (m_slideOffset >= 0) {
+    m_slideOffset = 0;
     setOpen();
   }
 }
@@ -560,26 +2142,33 @@ Console::setOpen()
 void
 Console::onWindowResize(const sf::Vector2u& windowSize)
 {
-  m_border.setSize(sf::Vector2f(windowSize.x, windowSize.y * m_style.getHeightPercentage()));
-  m_border.setPosition(0, 0);
+  m_border = sf::FloatRect(0, 0, windowSize.x, windowSize.y * m_style.getHeightPercentage());
+
+  m_background = sf::FloatRect(m_style.getMarginSize(),
+                               m_style.getMarginSize(),
+                               windowSize.x - 2 * m_style.getMarginSize(),
+                               windowSize.y * m_style.getHeightPercentage() - 2 * m_style.getMarginSize());
 
-  m_background.setSize(sf::Vector2f(windowSize.x - 2 * m_style.getMarginSize(),
-                                    windowSize.y * m_style.getHeightPercentage() - 2 * m_style.getMarginSize()));
-  m_background.setPosition(m_style.getMarginSize(), m_style.getMarginSize());
+  float inputY = (windowSize.y * m_style.getHeightPercentage() - 2 * m_style.getMarginSize()) - m_style.getFontSize();
 
-  m_sfCurrentInput.setPosition(m_style.getFontSize() / 2 + m_style.getFontSize(),
-                               (windowSize.y * m_style.getHeightPercentage()  - 2 * m_style.getMarginSize()) - m_style.getFontSize());
-  m_sfCurrentInput.setCharacterSize(m_style.getFontSize());
+  m_inputPosition = sf::Vector2f(m_style.getFontSize() / 2 + m_style.getFontSize(), inputY);
+  m_promptPosition = sf::Vector2f(m_style.getFontSize() / 2, inputY);
 
-  m_sfCursorMask.setPosition(m_style.getFontSize() / 2 + m_style.getFontSize(),
-                             (windowSize.y * m_style.getHeightPercentage()  - 2 * m_style.getMarginSize()) - m_style.getFontSize());
-  m_sfCursorMask.setCharacterSize(m_style.getFontSize());
+  m_visibleLines = (m_background.height - m_style.getFontSize()) / m_style.getFontSize();
 
-  m_prompt.setPosition(m_style.getFontSize() / 2,
-                       (windowSize.y * m_style.getHeightPercentage() - 2 * m_style.getMarginSize()) - m_style.getFontSize());
-  m_prompt.setCharacterSize(m_style.getFontSize());
+  // Output starts two margins in from the left, like the rest of layout(),
+  // and wraps one margin before the right edge of the background. Lines
+  // are wrapped again as they come into view.
+  float outputLeft = m_border.left + 2 * m_style.getMarginSize();
+  m_wraps.setWidth(m_background.left + m_background.width - m_style.getMarginSize() - outputLeft);
+  clampScroll();
+
+  // Keep a closed console just out of view at its new height
+  if (m_state == State::CLOSED) {
+    m_slideOffset = -m_border.height;
+  }
 
-  m_visibleLines = (m_background.getSize().y - m_style.getFontSize()) / m_style.getFontSize();
+  m_isDirty = true;
 }
 
 } // namespace impl
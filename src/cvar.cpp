@@ -0,0 +1,341 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "cvar.hpp"
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace sfmlConsole {
+
+//=============================================================================
+//  CvarBase::CvarBase()
+//-----------------------------------------------------------------------------
+CvarBase::CvarBase(const std::string& name, const std::string& description, Type type, PendingList& pending)
+  : m_name(name)
+  , m_description(description)
+  , m_type(type)
+  , m_pending(pending)
+  , m_nextPending(nullptr)
+  , m_isPending(false)
+{
+}
+
+//=============================================================================
+//  void CvarBase::markChanged()
+//-----------------------------------------------------------------------------
+void
+CvarBase::markChanged()
+{
+  // Only the first change since the last update links the cvar into the list
+  if (m_isPending.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  CvarBase* head = m_pending.load(std::memory_order_relaxed);
+
+  do {
+    m_nextPending = head;
+  } while (!m_pending.compare_exchange_weak(head, this, std::memory_order_release, std::memory_order_relaxed));
+}
+
+//=============================================================================
+//  CvarBase* CvarBase::takeNextPending()
+//-----------------------------------------------------------------------------
+CvarBase*
+CvarBase::takeNextPending()
+{
+  // Read the link before clearing the flag; once cleared another thread may
+  // link this cvar into the list again
+  CvarBase* next = m_nextPending;
+  m_isPending.store(false, std::memory_order_release);
+
+  return next;
+}
+
+//=============================================================================
+//  void CvarBase::notifyCallback()
+//-----------------------------------------------------------------------------
+void
+CvarBase::notifyCallback() const
+{
+  if (m_callback) {
+    m_callback(*this);
+  }
+}
+
+//=============================================================================
+//  Type cvarType()
+//-----------------------------------------------------------------------------
+template <typename T>
+static CvarBase::Type
+cvarType();
+
+template <>
+CvarBase::Type
+cvarType<int>()
+{
+  return CvarBase::Type::INT;
+}
+
+template <>
+CvarBase::Type
+cvarType<float>()
+{
+  return CvarBase::Type::FLOAT;
+}
+
+template <>
+CvarBase::Type
+cvarType<bool>()
+{
+  return CvarBase::Type::BOOL;
+}
+
+//=============================================================================
+//  Cvar<T>::Cvar()
+//-----------------------------------------------------------------------------
+template <typename T>
+Cvar<T>::Cvar(const std::string& name, const std::string& description, T value, PendingList& pending)
+  : CvarBase(name, description, cvarType<T>(), pending)
+  , m_value(value)
+{
+}
+
+//=============================================================================
+//  bool Cvar<T>::setFromString()
+//-----------------------------------------------------------------------------
+template <>
+bool
+Cvar<int>::setFromString(std::string_view value)
+{
+  int parsed;
+  std::from_chars_result result = std::from_chars(value.data(), value.data() + value.size(), parsed);
+
+  if (result.ec != std::errc() || result.ptr != value.data() + value.size()) {
+    return false;
+  }
+
+  set(parsed);
+  return true;
+}
+
+template <>
+bool
+Cvar<float>::setFromString(std::string_view value)
+{
+  // strtof needs a terminated string; cvar values are short
+  char buffer[64];
+
+  if (value.empty() || value.size() >= sizeof(buffer)) {
+    return false;
+  }
+
+  std::memcpy(buffer, value.data(), value.size());
+  buffer[value.size()] = '\0';
+
+  char* end;
+  float parsed = std::strtof(buffer, &end);
+
+  if (end != buffer + value.size()) {
+    return false;
+  }
+
+  set(parsed);
+  return true;
+}
+
+template <>
+bool
+Cvar<bool>::setFromString(std::string_view value)
+{
+  if (value == "1" || value == "true" || value == "on" || value == "yes") {
+    set(true);
+  }
+  else if (value == "0" || value == "false" || value == "off" || value == "no") {
+    set(false);
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+//=============================================================================
+//  std::string Cvar<T>::toString()
+//-----------------------------------------------------------------------------
+template <>
+std::string
+Cvar<int>::toString() const
+{
+  return std::to_string(get());
+}
+
+template <>
+std::string
+Cvar<float>::toString() const
+{
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%g", get());
+
+  return buffer;
+}
+
+template <>
+std::string
+Cvar<bool>::toString() const
+{
+  return get() ? "true" : "false";
+}
+
+template class Cvar<int>;
+template class Cvar<float>;
+template class Cvar<bool>;
+
+//=============================================================================
+//  Cvar<std::string>::Cvar()
+//-----------------------------------------------------------------------------
+Cvar<std::string>::Cvar(const std::string& name,
+                        const std::string& description,
+                        std::string_view value,
+                        PendingList& pending)
+  : CvarBase(name, description, Type::STRING, pending)
+  , m_sequence(0)
+{
+  for (std::atomic<uint64_t>& word : m_words) {
+    word.store(0, std::memory_order_relaxed);
+  }
+
+  store(value);
+}
+
+//=============================================================================
+//  std::string Cvar<std::string>::get()
+//-----------------------------------------------------------------------------
+std::string
+Cvar<std::string>::get() const
+{
+  // The first byte holds the length, the value follows it
+  uint64_t words[WORD_COUNT];
+  uint32_t sequence;
+
+  for (;;) {
+    sequence = m_sequence.load(std::memory_order_acquire);
+
+    // A write is in progress
+    if (sequence & 1) {
+      continue;
+    }
+
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+      words[i] = m_words[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (m_sequence.load(std::memory_order_relaxed) == sequence) {
+      break;
+    }
+  }
+
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(words);
+  return std::string(reinterpret_cast<const char*>(bytes + 1), bytes[0]);
+}
+
+//=============================================================================
+//  void Cvar<std::string>::set()
+//-----------------------------------------------------------------------------
+void
+Cvar<std::string>::set(std::string_view value)
+{
+  if (store(value)) {
+    markChanged();
+  }
+}
+
+//=============================================================================
+//  bool Cvar<std::string>::store()
+//-----------------------------------------------------------------------------
+bool
+Cvar<std::string>::store(std::string_view value)
+{
+  if (value.size() > MAX_LENGTH) {
+    value = value.substr(0, MAX_LENGTH);
+  }
+
+  uint64_t words[WORD_COUNT] = {};
+  unsigned char* bytes = reinterpret_cast<unsigned char*>(words);
+
+  bytes[0] = static_cast<unsigned char>(value.size());
+  std::memcpy(bytes + 1, value.data(), value.size());
+
+  {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+
+    bool isChanged = false;
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+      isChanged = isChanged || m_words[i].load(std::memory_order_relaxed) != words[i];
+    }
+
+    if (!isChanged) {
+      return false;
+    }
+
+    // An odd sequence tells readers that the words are being written
+    uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+      m_words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  return true;
+}
+
+//=============================================================================
+//  bool Cvar<std::string>::setFromString()
+//-----------------------------------------------------------------------------
+bool
+Cvar<std::string>::setFromString(std::string_view value)
+{
+  set(value);
+  return true;
+}
+
+//=============================================================================
+//  std::string Cvar<std::string>::toString()
+//-----------------------------------------------------------------------------
+std::string
+Cvar<std::string>::toString() const
+{
+  return get();
+}
+
+} // namespace sfmlConsole
@@ -0,0 +1,111 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "glyph-advances.hpp"
+#include "text-batch.hpp"
+
+#include <SFML/Graphics/Font.hpp>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Narrow and wide characters that proportional fonts never give the same
+// advance
+const char MONOSPACE_SAMPLE[] = " .iljmMW0";
+
+//=============================================================================
+//  GlyphAdvances::GlyphAdvances()
+//-----------------------------------------------------------------------------
+GlyphAdvances::GlyphAdvances(const sf::Font& font, unsigned int characterSize)
+  : m_font(font)
+  , m_characterSize(characterSize)
+  , m_isMonospace(false)
+{
+  m_advances.fill(-1);
+}
+
+//=============================================================================
+//  bool GlyphAdvances::isMonospace()
+//-----------------------------------------------------------------------------
+bool
+GlyphAdvances::isMonospace(const sf::Font& font, unsigned int characterSize)
+{
+  float advance = font.getGlyph(MONOSPACE_SAMPLE[0], characterSize, false).advance;
+
+  for (const char* c = MONOSPACE_SAMPLE + 1; *c != '\0'; ++c) {
+    if (font.getGlyph(static_cast<unsigned char>(*c), characterSize, false).advance != advance) {
+      return false;
+    }
+  }
+
+  return advance > 0;
+}
+
+//=============================================================================
+//  void GlyphAdvances::setCharacterSize()
+//-----------------------------------------------------------------------------
+void
+GlyphAdvances::setCharacterSize(unsigned int characterSize)
+{
+  m_characterSize = characterSize;
+  m_advances.fill(-1);
+}
+
+//=============================================================================
+//  void GlyphAdvances::setMonospace()
+//-----------------------------------------------------------------------------
+void
+GlyphAdvances::setMonospace(bool isMonospace)
+{
+  m_isMonospace = isMonospace;
+  m_advances.fill(-1);
+}
+
+//=============================================================================
+//  float GlyphAdvances::get()
+//-----------------------------------------------------------------------------
+float
+GlyphAdvances::get(uint32_t previous, uint32_t c)
+{
+  float kerning = previous != 0 && !m_isMonospace ? m_font.getKerning(previous, c, m_characterSize) : 0;
+  float& advance = m_advances[c & 0xFF];
+
+  if (advance < 0) {
+    if (c == '\t') {
+      advance = m_font.getGlyph(' ', m_characterSize, false).advance * TextBatch::TAB_WIDTH;
+    }
+    else if (c == '\n' || c == '\r') {
+      advance = 0;
+    }
+    else {
+      // Forced onto a proportional font, monospace layout still puts every
+      // character one space apart
+      advance = m_font.getGlyph(m_isMonospace ? ' ' : c, m_characterSize, false).advance;
+    }
+  }
+
+  return kerning + advance;
+}
+
+} // namespace impl
+} // namespace sfmlConsole
@@ -0,0 +1,254 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "history-file.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+
+namespace sfmlConsole {
+namespace impl {
+
+// "SFCH" read as a little-endian word
+const uint32_t HistoryFile::MAGIC = 0x48434653;
+
+const uint32_t HistoryFile::VERSION = 1;
+
+const size_t HistoryFile::HEADER_SIZE = 2 * sizeof(uint32_t);
+
+namespace {
+
+bool
+writeHeader(FILE* file)
+{
+  uint32_t header[] = { HistoryFile::MAGIC, HistoryFile::VERSION };
+  return std::fwrite(header, sizeof(header), 1, file) == 1;
+}
+
+} // namespace
+
+//=============================================================================
+//  HistoryFile::HistoryFile()
+//-----------------------------------------------------------------------------
+HistoryFile::HistoryFile()
+  : m_file(nullptr)
+  , m_isCompacting(false)
+  , m_isCompacted(false)
+  , m_isCompactionWritten(false)
+{
+}
+
+HistoryFile::~HistoryFile()
+{
+  if (m_isCompacting) {
+    finishCompaction();
+  }
+
+  if (m_file != nullptr) {
+    std::fclose(m_file);
+  }
+}
+
+//=============================================================================
+//  bool HistoryFile::open()
+//-----------------------------------------------------------------------------
+bool
+HistoryFile::open(const std::string& path, std::string& records)
+{
+  records.clear();
+
+  if (FILE* file = std::fopen(path.c_str(), "rb")) {
+    std::string contents;
+
+    if (std::fseek(file, 0, SEEK_END) == 0) {
+      long size = std::ftell(file);
+      std::rewind(file);
+
+      if (size > 0) {
+        contents.resize(static_cast<size_t>(size));
+        contents.resize(std::fread(&contents[0], 1, contents.size(), file));
+      }
+    }
+
+    std::fclose(file);
+
+    if (!contents.empty()) {
+      uint32_t header[2] = { 0, 0 };
+
+      if (contents.size() >= HEADER_SIZE) {
+        std::memcpy(header, contents.data(), HEADER_SIZE);
+      }
+
+      if (header[0] != MAGIC || header[1] != VERSION) {
+        return false;
+      }
+
+      // Keep the complete records only
+      size_t end = HEADER_SIZE;
+      while (end + sizeof(uint32_t) <= contents.size()) {
+        uint32_t length;
+        std::memcpy(&length, contents.data() + end, sizeof(length));
+
+        if (contents.size() - end - sizeof(length) < length) {
+          break;
+        }
+
+        end += sizeof(length) + length;
+      }
+
+      if (end < contents.size()) {
+        std::error_code error;
+        std::filesystem::resize_file(path, end, error);
+      }
+
+      // The records are handed over without copying the entries
+      contents.erase(end);
+      contents.erase(0, HEADER_SIZE);
+      records.swap(contents);
+    }
+  }
+
+  m_file = std::fopen(path.c_str(), "ab");
+  if (m_file == nullptr) {
+    records.clear();
+    return false;
+  }
+
+  // A new or empty file starts with the header. Where an append stream is
+  // positioned before its first write is up to the platform, so seek to the
+  // end before asking.
+  if (std::fseek(m_file, 0, SEEK_END) != 0) {
+    std::fclose(m_file);
+    m_file = nullptr;
+    records.clear();
+    return false;
+  }
+
+  if (std::ftell(m_file) == 0 && !(writeHeader(m_file) && std::fflush(m_file) == 0)) {
+    std::fclose(m_file);
+    m_file = nullptr;
+    records.clear();
+    return false;
+  }
+
+  m_path = path;
+
+  return true;
+}
+
+//=============================================================================
+//  void HistoryFile::append()
+//-----------------------------------------------------------------------------
+void
+HistoryFile::append(std::string_view record)
+{
+  if (m_file == nullptr) {
+    return;
+  }
+
+  // Flushed every time, entries are rare and should survive a crash
+  std::fwrite(record.data(), 1, record.size(), m_file);
+  std::fflush(m_file);
+
+  if (m_isCompacting) {
+    m_pendingRecords.append(record.data(), record.size());
+  }
+}
+
+//=============================================================================
+//  void HistoryFile::compact()
+//-----------------------------------------------------------------------------
+void
+HistoryFile::compact(std::string records)
+{
+  if (m_file == nullptr || m_isCompacting) {
+    return;
+  }
+
+  m_isCompacting = true;
+  m_isCompacted.store(false, std::memory_order_relaxed);
+  m_pendingRecords.clear();
+
+  std::string path = m_path + ".tmp";
+
+  m_compactor = std::thread([this, path, records = std::move(records)] {
+    bool isWritten = false;
+
+    if (FILE* file = std::fopen(path.c_str(), "wb")) {
+      isWritten = writeHeader(file) && std::fwrite(records.data(), 1, records.size(), file) == records.size();
+      isWritten = std::fclose(file) == 0 && isWritten;
+    }
+
+    m_isCompactionWritten = isWritten;
+    m_isCompacted.store(true, std::memory_order_release);
+  });
+}
+
+//=============================================================================
+//  void HistoryFile::poll()
+//-----------------------------------------------------------------------------
+void
+HistoryFile::poll()
+{
+  if (m_isCompacting && m_isCompacted.load(std::memory_order_acquire)) {
+    finishCompaction();
+  }
+}
+
+//=============================================================================
+//  void HistoryFile::finishCompaction()
+//-----------------------------------------------------------------------------
+void
+HistoryFile::finishCompaction()
+{
+  m_compactor.join();
+  m_isCompacting = false;
+
+  std::string path = m_path + ".tmp";
+  bool isWritten = m_isCompactionWritten;
+
+  // Add what was appended to the old file in the meantime
+  if (isWritten && !m_pendingRecords.empty()) {
+    isWritten = false;
+
+    if (FILE* file = std::fopen(path.c_str(), "ab")) {
+      isWritten = std::fwrite(m_pendingRecords.data(), 1, m_pendingRecords.size(), file) == m_pendingRecords.size();
+      isWritten = std::fclose(file) == 0 && isWritten;
+    }
+  }
+
+  m_pendingRecords.clear();
+
+  // The old file stays in use if anything went wrong
+  if (!isWritten || std::rename(path.c_str(), m_path.c_str()) != 0) {
+    std::remove(path.c_str());
+    return;
+  }
+
+  std::fclose(m_file);
+  m_file = std::fopen(m_path.c_str(), "ab");
+}
+
+} // namespace impl
+} // namespace sfmlConsole
@@ -0,0 +1,317 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "input-history.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <limits>
+
+namespace sfmlConsole {
+namespace impl {
+
+const size_t InputHistory::NO_MATCH = static_cast<size_t>(-1);
+
+//=============================================================================
+//  InputHistory::InputHistory()
+//-----------------------------------------------------------------------------
+InputHistory::InputHistory()
+  : m_first(0)
+  , m_capacity(std::numeric_limits<size_t>::max())
+  , m_nFileRecords(0)
+  , m_byCharacter(256)
+  , m_nIndexed(0)
+  , m_isSearching(false)
+  , m_matchRank(0)
+{
+}
+
+//=============================================================================
+//  bool InputHistory::open()
+//-----------------------------------------------------------------------------
+bool
+InputHistory::open(const std::string& path, size_t capacity)
+{
+  std::string records;
+  if (m_file.isOpen() || !m_file.open(path, records)) {
+    return false;
+  }
+
+  std::vector<std::string> typed;
+  for (size_t i = 0; i < size(); ++i) {
+    typed.emplace_back(at(i));
+  }
+
+  // Index the records where they were read, without copying the entries
+  clear();
+  m_records.swap(records);
+  m_capacity = std::max<size_t>(capacity, 1);
+
+  size_t offset = 0;
+  while (offset < m_records.size()) {
+    uint32_t length;
+    std::memcpy(&length, m_records.data() + offset, sizeof(length));
+    offset += sizeof(length);
+
+    m_offsets.push_back(offset);
+    offset += length;
+  }
+
+  m_nFileRecords = m_offsets.size();
+  m_first = m_offsets.size() > m_capacity ? m_offsets.size() - m_capacity : 0;
+
+  if (m_first > 0) {
+    rebuild();
+  }
+
+  for (const std::string& entry : typed) {
+    push(entry);
+  }
+
+  if (m_nFileRecords > 2 * m_capacity) {
+    m_file.compact(getLiveRecords());
+    m_nFileRecords = size();
+  }
+
+  return true;
+}
+
+//=============================================================================
+//  void InputHistory::push()
+//-----------------------------------------------------------------------------
+void
+InputHistory::push(std::string_view entry)
+{
+  if (entry.empty() || (size() > 0 && at(size() - 1) == entry)) {
+    return;
+  }
+
+  uint32_t length = static_cast<uint32_t>(entry.size());
+  size_t recordOffset = m_records.size();
+
+  m_records.append(reinterpret_cast<const char*>(&length), sizeof(length));
+  m_records.append(entry.data(), entry.size());
+  m_offsets.push_back(recordOffset + sizeof(length));
+
+  if (m_file.isOpen()) {
+    m_file.append(std::string_view(m_records.data() + recordOffset, sizeof(length) + entry.size()));
+    m_nFileRecords++;
+  }
+
+  if (size() > m_capacity) {
+    m_first++;
+
+    // Reclaim the space once half of it is forgotten
+    if (m_first >= m_capacity) {
+      rebuild();
+    }
+  }
+
+  if (m_nFileRecords > 2 * m_capacity && !m_file.isCompacting()) {
+    m_file.compact(getLiveRecords());
+    m_nFileRecords = size();
+  }
+}
+
+//=============================================================================
+//  void InputHistory::clear()
+//-----------------------------------------------------------------------------
+void
+InputHistory::clear()
+{
+  endSearch();
+  m_records.clear();
+  m_offsets.clear();
+  m_first = 0;
+
+  for (Matches& entries : m_byCharacter) {
+    entries.clear();
+  }
+
+  m_nIndexed = 0;
+}
+
+//=============================================================================
+//  void InputHistory::updateIndex()
+//-----------------------------------------------------------------------------
+void
+InputHistory::updateIndex()
+{
+  for (; m_nIndexed < m_offsets.size(); ++m_nIndexed) {
+    // List each entry once per distinct character
+    std::bitset<256> isListed;
+
+    for (char c : getEntry(m_nIndexed)) {
+      unsigned char byte = static_cast<unsigned char>(c);
+
+      if (!isListed[byte]) {
+        isListed[byte] = true;
+        m_byCharacter[byte].push_back(static_cast<uint32_t>(m_nIndexed));
+      }
+    }
+  }
+}
+
+//=============================================================================
+//  std::string InputHistory::getLiveRecords()
+//-----------------------------------------------------------------------------
+std::string
+InputHistory::getLiveRecords() const
+{
+  if (size() == 0) {
+    return std::string();
+  }
+
+  return m_records.substr(m_offsets[m_first] - sizeof(uint32_t));
+}
+
+//=============================================================================
+//  void InputHistory::rebuild()
+//-----------------------------------------------------------------------------
+void
+InputHistory::rebuild()
+{
+  endSearch();
+
+  size_t begin = m_first < m_offsets.size() ? m_offsets[m_first] - sizeof(uint32_t) : m_records.size();
+  m_records.erase(0, begin);
+
+  std::vector<size_t> offsets(m_offsets.begin() + m_first, m_offsets.end());
+  for (size_t& offset : offsets) {
+    offset -= begin;
+  }
+
+  m_offsets.swap(offsets);
+  m_first = 0;
+
+  for (Matches& entries : m_byCharacter) {
+    entries.clear();
+  }
+
+  m_nIndexed = 0;
+}
+
+//=============================================================================
+//  void InputHistory::beginSearch()
+//-----------------------------------------------------------------------------
+void
+InputHistory::beginSearch()
+{
+  updateIndex();
+
+  m_isSearching = true;
+  m_query.clear();
+  m_matches.clear();
+  m_matchRank = 0;
+}
+
+//=============================================================================
+//  void InputHistory::endSearch()
+//-----------------------------------------------------------------------------
+void
+InputHistory::endSearch()
+{
+  m_isSearching = false;
+  m_query.clear();
+  m_matches.clear();
+  m_matchRank = 0;
+}
+
+//=============================================================================
+//  void InputHistory::pushSearchCharacter()
+//-----------------------------------------------------------------------------
+void
+InputHistory::pushSearchCharacter(char c)
+{
+  m_query += c;
+  m_matchRank = 0;
+
+  if (m_matches.empty()) {
+    // Forgotten entries are still listed until the next rebuild
+    const Matches& entries = m_byCharacter[static_cast<unsigned char>(c)];
+    Matches::const_iterator begin = std::lower_bound(entries.begin(), entries.end(), m_first);
+
+    m_matches.emplace_back(begin, entries.end());
+    return;
+  }
+
+  // Entries matching the longer query are among those matching the shorter
+  // one, so only those are checked
+  const Matches& previous = m_matches.back();
+  Matches narrowed;
+
+  for (uint32_t position : previous) {
+    if (getEntry(position).find(m_query) != std::string_view::npos) {
+      narrowed.push_back(position);
+    }
+  }
+
+  m_matches.push_back(std::move(narrowed));
+}
+
+//=============================================================================
+//  void InputHistory::popSearchCharacter()
+//-----------------------------------------------------------------------------
+void
+InputHistory::popSearchCharacter()
+{
+  if (m_query.empty()) {
+    return;
+  }
+
+  m_query.pop_back();
+  m_matches.pop_back();
+  m_matchRank = 0;
+}
+
+//=============================================================================
+//  bool InputHistory::searchOlder()
+//-----------------------------------------------------------------------------
+bool
+InputHistory::searchOlder()
+{
+  if (m_matches.empty() || m_matchRank + 1 >= m_matches.back().size()) {
+    return false;
+  }
+
+  m_matchRank++;
+
+  return true;
+}
+
+//=============================================================================
+//  size_t InputHistory::getMatch()
+//-----------------------------------------------------------------------------
+size_t
+InputHistory::getMatch() const
+{
+  if (m_matches.empty() || m_matchRank >= m_matches.back().size()) {
+    return NO_MATCH;
+  }
+
+  const Matches& matches = m_matches.back();
+  return matches[matches.size() - 1 - m_matchRank] - m_first;
+}
+
+} // namespace impl
+} // namespace sfmlConsole
@@ -0,0 +1,381 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "line-editor.hpp"
+
+#include <algorithm>
+
+namespace sfmlConsole {
+namespace impl {
+
+// The gap never starts smaller than this
+const size_t MIN_CAPACITY = 64;
+
+//=============================================================================
+//  LineEditor::LineEditor()
+//-----------------------------------------------------------------------------
+LineEditor::LineEditor(const sf::Font& font, unsigned int characterSize)
+  : m_advances(font, characterSize)
+  , m_gapBegin(0)
+  , m_gapEnd(0)
+  , m_cursor(0)
+{
+}
+
+//=============================================================================
+//  void LineEditor::setCharacterSize()
+//-----------------------------------------------------------------------------
+void
+LineEditor::setCharacterSize(unsigned int characterSize)
+{
+  if (characterSize == m_advances.getCharacterSize()) {
+    return;
+  }
+
+  m_advances.setCharacterSize(characterSize);
+
+  size_t cursor = m_cursor;
+  assign(std::string(getText()));
+  m_cursor = cursor;
+}
+
+//=============================================================================
+//  void LineEditor::setMonospace()
+//-----------------------------------------------------------------------------
+void
+LineEditor::setMonospace(bool isMonospace)
+{
+  if (isMonospace == m_advances.isMonospace()) {
+    return;
+  }
+
+  m_advances.setMonospace(isMonospace);
+
+  size_t cursor = m_cursor;
+  assign(std::string(getText()));
+  m_cursor = cursor;
+}
+
+//=============================================================================
+//  void LineEditor::insert()
+//-----------------------------------------------------------------------------
+void
+LineEditor::insert(char c)
+{
+  moveGap(m_cursor);
+  reserveGap(1);
+
+  pushBeforeGap(c);
+  updateFirstAfterGap();
+
+  m_cursor++;
+}
+
+void
+LineEditor::insert(std::string_view text)
+{
+  if (text.empty()) {
+    return;
+  }
+
+  // One move and at most one reallocation for the whole text
+  moveGap(m_cursor);
+  reserveGap(text.size());
+
+  for (char c : text) {
+    pushBeforeGap(c);
+  }
+
+  updateFirstAfterGap();
+
+  m_cursor += text.size();
+}
+
+//=============================================================================
+//  void LineEditor::assign()
+//-----------------------------------------------------------------------------
+void
+LineEditor::assign(std::string_view text)
+{
+  clear();
+  insert(text);
+}
+
+//=============================================================================
+//  void LineEditor::clear()
+//-----------------------------------------------------------------------------
+void
+LineEditor::clear()
+{
+  // The buffers keep their capacity as one big gap
+  m_gapBegin = 0;
+  m_gapEnd = m_text.size();
+  m_cursor = 0;
+}
+
+//=============================================================================
+//  bool LineEditor::erase()
+//-----------------------------------------------------------------------------
+bool
+LineEditor::erase()
+{
+  if (m_cursor == 0) {
+    return false;
+  }
+
+  moveGap(m_cursor);
+  m_gapBegin--;
+  m_cursor--;
+
+  updateFirstAfterGap();
+
+  return true;
+}
+
+//=============================================================================
+//  bool LineEditor::eraseForward()
+//-----------------------------------------------------------------------------
+bool
+LineEditor::eraseForward()
+{
+  if (m_cursor == size()) {
+    return false;
+  }
+
+  moveGap(m_cursor);
+  m_gapEnd++;
+
+  updateFirstAfterGap();
+
+  return true;
+}
+
+//=============================================================================
+//  void LineEditor::moveLeft()
+//-----------------------------------------------------------------------------
+void
+LineEditor::moveLeft()
+{
+  if (m_cursor > 0) {
+    m_cursor--;
+  }
+}
+
+//=============================================================================
+//  void LineEditor::moveRight()
+//-----------------------------------------------------------------------------
+void
+LineEditor::moveRight()
+{
+  if (m_cursor < size()) {
+    m_cursor++;
+  }
+}
+
+//=============================================================================
+//  void LineEditor::moveWordLeft()
+//-----------------------------------------------------------------------------
+void
+LineEditor::moveWordLeft()
+{
+  while (m_cursor > 0 && isBlank(at(m_cursor - 1))) {
+    m_cursor--;
+  }
+
+  while (m_cursor > 0 && !isBlank(at(m_cursor - 1))) {
+    m_cursor--;
+  }
+}
+
+//=============================================================================
+//  void LineEditor::moveWordRight()
+//-----------------------------------------------------------------------------
+void
+LineEditor::moveWordRight()
+{
+  size_t length = size();
+
+  while (m_cursor < length && isBlank(at(m_cursor))) {
+    m_cursor++;
+  }
+
+  while (m_cursor < length && !isBlank(at(m_cursor))) {
+    m_cursor++;
+  }
+}
+
+//=============================================================================
+//  std::string_view LineEditor::getText()
+//-----------------------------------------------------------------------------
+std::string_view
+LineEditor::getText() const
+{
+  moveGap(size());
+
+  return std::string_view(m_text.data(), m_gapBegin);
+}
+
+//=============================================================================
+//  void LineEditor::copy()
+//-----------------------------------------------------------------------------
+void
+LineEditor::copy(size_t begin, size_t end, std::string& out) const
+{
+  out.clear();
+
+  end = std::min(end, size());
+  if (begin >= end) {
+    return;
+  }
+
+  // Up to the gap, then past it
+  size_t split = std::min(std::max(begin, m_gapBegin), end);
+
+  out.append(m_text.data() + begin, split - begin);
+  out.append(m_text.data() + split + getGapSize(), end - split);
+}
+
+//=============================================================================
+//  float LineEditor::getX()
+//-----------------------------------------------------------------------------
+float
+LineEditor::getX(size_t index) const
+{
+  if (index >= size()) {
+    return getWidth();
+  }
+
+  if (index <= m_gapBegin) {
+    return index > 0 ? static_cast<float>(m_extents[index - 1]) : 0;
+  }
+
+  return static_cast<float>(getWidthBeforeGap() + getWidthAfterGap() - m_extents[index + getGapSize()]);
+}
+
+//=============================================================================
+//  size_t LineEditor::findIndex()
+//-----------------------------------------------------------------------------
+size_t
+LineEditor::findIndex(float x) const
+{
+  size_t low = 0;
+  size_t high = size();
+
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+
+    if (getX(middle) < x) {
+      low = middle + 1;
+    }
+    else {
+      high = middle;
+    }
+  }
+
+  return low;
+}
+
+//=============================================================================
+//  void LineEditor::moveGap()
+//-----------------------------------------------------------------------------
+void
+LineEditor::moveGap(size_t position) const
+{
+  // A character crossing the gap keeps its width, only how its extent is
+  // measured changes
+  while (m_gapBegin > position) {
+    size_t from = m_gapBegin - 1;
+    double width = m_extents[from] - (from > 0 ? m_extents[from - 1] : 0);
+    double after = getWidthAfterGap();
+
+    m_gapBegin--;
+    m_gapEnd--;
+    m_text[m_gapEnd] = m_text[from];
+    m_extents[m_gapEnd] = after + width;
+  }
+
+  while (m_gapBegin < position) {
+    double width = m_extents[m_gapEnd] - (m_gapEnd + 1 < m_extents.size() ? m_extents[m_gapEnd + 1] : 0);
+    double before = getWidthBeforeGap();
+
+    m_text[m_gapBegin] = m_text[m_gapEnd];
+    m_extents[m_gapBegin] = before + width;
+    m_gapBegin++;
+    m_gapEnd++;
+  }
+}
+
+//=============================================================================
+//  void LineEditor::reserveGap()
+//-----------------------------------------------------------------------------
+void
+LineEditor::reserveGap(size_t count)
+{
+  if (getGapSize() >= count) {
+    return;
+  }
+
+  size_t nAfter = m_text.size() - m_gapEnd;
+  size_t capacity = std::max({ m_text.size() * 2, size() + count, MIN_CAPACITY });
+
+  m_text.resize(capacity);
+  m_extents.resize(capacity);
+
+  // The text after the gap moves to the new end
+  std::copy_backward(m_text.begin() + m_gapEnd, m_text.begin() + m_gapEnd + nAfter, m_text.end());
+  std::copy_backward(m_extents.begin() + m_gapEnd, m_extents.begin() + m_gapEnd + nAfter, m_extents.end());
+
+  m_gapEnd = capacity - nAfter;
+}
+
+//=============================================================================
+//  void LineEditor::pushBeforeGap()
+//-----------------------------------------------------------------------------
+void
+LineEditor::pushBeforeGap(char c)
+{
+  uint32_t previous = m_gapBegin > 0 ? static_cast<unsigned char>(m_text[m_gapBegin - 1]) : 0;
+
+  m_text[m_gapBegin] = c;
+  m_extents[m_gapBegin] = getWidthBeforeGap() + m_advances.get(previous, static_cast<unsigned char>(c));
+  m_gapBegin++;
+}
+
+//=============================================================================
+//  void LineEditor::updateFirstAfterGap()
+//-----------------------------------------------------------------------------
+void
+LineEditor::updateFirstAfterGap()
+{
+  if (m_gapEnd == m_text.size()) {
+    return;
+  }
+
+  uint32_t previous = m_gapBegin > 0 ? static_cast<unsigned char>(m_text[m_gapBegin - 1]) : 0;
+  double rest = m_gapEnd + 1 < m_extents.size() ? m_extents[m_gapEnd + 1] : 0;
+
+  m_extents[m_gapEnd] = rest + m_advances.get(previous, static_cast<unsigned char>(m_text[m_gapEnd]));
+}
+
+} // namespace impl
+} // namespace sfmlConsole
@@ -0,0 +1,213 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "log-sink.hpp"
+
+namespace sfmlConsole {
+namespace impl {
+
+const size_t LogSink::BATCH_SIZE = 64 * 1024;
+
+const size_t LogSink::MAX_PENDING_SIZE = 16 * 1024 * 1024;
+
+const std::chrono::milliseconds LogSink::FLUSH_INTERVAL(250);
+
+//=============================================================================
+//  LogSink::LogSink()
+//-----------------------------------------------------------------------------
+LogSink::LogSink(const std::string& path, size_t maxFileSize, size_t maxFiles)
+  : m_path(path)
+  , m_maxFileSize(maxFileSize)
+  , m_maxFiles(maxFiles)
+  , m_isOpen(false)
+  , m_file(std::fopen(path.c_str(), "ab"))
+  , m_fileSize(0)
+  , m_dropped(0)
+  , m_isStopping(false)
+{
+  if (m_file == nullptr) {
+    return;
+  }
+
+  // Appending to an existing log counts towards its size
+  if (std::fseek(m_file, 0, SEEK_END) == 0) {
+    long size = std::ftell(m_file);
+    m_fileSize = size > 0 ? static_cast<size_t>(size) : 0;
+  }
+
+  m_isOpen = true;
+  m_pending.reserve(BATCH_SIZE * 2);
+  m_writer = std::thread(&LogSink::run, this);
+}
+
+//=============================================================================
+//  LogSink::~LogSink()
+//-----------------------------------------------------------------------------
+LogSink::~LogSink()
+{
+  if (m_writer.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isStopping = true;
+    }
+
+    m_condition.notify_one();
+    m_writer.join();
+  }
+
+  if (m_file != nullptr) {
+    std::fclose(m_file);
+  }
+}
+
+//=============================================================================
+//  void LogSink::write()
+//-----------------------------------------------------------------------------
+void
+LogSink::write(std::string_view line)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  if (m_pending.size() + line.size() + 1 > MAX_PENDING_SIZE) {
+    m_dropped++;
+    return;
+  }
+
+  bool wasBelowBatch = m_pending.size() < BATCH_SIZE;
+
+  m_pending.append(line);
+  m_pending += '\n';
+
+  // Only wake the writer once per batch, not for every line after it
+  bool isBatchReady = wasBelowBatch && m_pending.size() >= BATCH_SIZE;
+
+  lock.unlock();
+
+  if (isBatchReady) {
+    m_condition.notify_one();
+  }
+}
+
+//=============================================================================
+//  void LogSink::run()
+//-----------------------------------------------------------------------------
+void
+LogSink::run()
+{
+  std::string batch;
+  batch.reserve(BATCH_SIZE * 2);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  for (;;) {
+    m_condition.wait_for(lock, FLUSH_INTERVAL, [this] {
+      return m_isStopping || m_pending.size() >= BATCH_SIZE;
+    });
+
+    // Swapping hands the emptied buffer back to writers, so neither side
+    // allocates once both have grown to a batch
+    batch.swap(m_pending);
+    size_t dropped = m_dropped;
+    m_dropped = 0;
+    bool isStopping = m_isStopping;
+
+    lock.unlock();
+
+    if (dropped > 0) {
+      batch += "[" + std::to_string(dropped) + " lines dropped, the log could not keep up]\n";
+    }
+
+    if (!batch.empty()) {
+      writeBatch(batch);
+      std::fflush(m_file);
+      batch.clear();
+    }
+
+    lock.lock();
+
+    if (isStopping && m_pending.empty()) {
+      break;
+    }
+  }
+}
+
+//=============================================================================
+//  void LogSink::writeBatch()
+//-----------------------------------------------------------------------------
+void
+LogSink::writeBatch(const std::string& batch)
+{
+  size_t begin = 0;
+
+  while (begin < batch.size() && m_file != nullptr) {
+    size_t end = batch.size();
+    size_t room = m_fileSize < m_maxFileSize ? m_maxFileSize - m_fileSize : 0;
+
+    if (end - begin > room) {
+      // Cut after the last whole line that still fits
+      size_t cut = room > 0 ? batch.rfind('\n', begin + room - 1) : std::string::npos;
+
+      if (cut != std::string::npos && cut >= begin) {
+        end = cut + 1;
+      }
+      else if (m_fileSize > 0) {
+        rotate();
+        continue;
+      }
+      else {
+        // A line longer than the limit gets a file of its own
+        end = batch.find('\n', begin) + 1;
+      }
+    }
+
+    m_fileSize += std::fwrite(batch.data() + begin, 1, end - begin, m_file);
+    begin = end;
+  }
+}
+
+//=============================================================================
+//  void LogSink::rotate()
+//-----------------------------------------------------------------------------
+void
+LogSink::rotate()
+{
+  std::fclose(m_file);
+
+  if (m_maxFiles > 0) {
+    std::remove((m_path + "." + std::to_string(m_maxFiles)).c_str());
+
+    for (size_t i = m_maxFiles - 1; i > 0; --i) {
+      std::rename((m_path + "." + std::to_string(i)).c_str(),
+                  (m_path + "." + std::to_string(i + 1)).c_str());
+    }
+
+    std::rename(m_path.c_str(), (m_path + ".1").c_str());
+  }
+
+  // Without rotated files to keep, the log starts over
+  m_file = std::fopen(m_path.c_str(), "wb");
+  m_fileSize = 0;
+}
+
+} // namespace impl
+} // namespace sfmlConsole
@@ -0,0 +1,270 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "markup-parser.hpp"
+
+#include <algorithm>
+
+namespace sfmlConsole {
+namespace impl {
+
+namespace {
+
+const char ESCAPE = '\033';
+
+// xterm's standard colors followed by their bright versions
+const sf::Color STANDARD_COLORS[16] = {
+  sf::Color(0, 0, 0),       sf::Color(205, 0, 0),     sf::Color(0, 205, 0),     sf::Color(205, 205, 0),
+  sf::Color(0, 0, 238),     sf::Color(205, 0, 205),   sf::Color(0, 205, 205),   sf::Color(229, 229, 229),
+  sf::Color(127, 127, 127), sf::Color(255, 0, 0),     sf::Color(0, 255, 0),     sf::Color(255, 255, 0),
+  sf::Color(92, 92, 255),   sf::Color(255, 0, 255),   sf::Color(0, 255, 255),   sf::Color(255, 255, 255)
+};
+
+// The 256 color palette: the standard colors, a 6x6x6 cube and 24 grays
+sf::Color
+getPaletteColor(int index)
+{
+  if (index < 16) {
+    return STANDARD_COLORS[index];
+  }
+
+  if (index < 232) {
+    const sf::Uint8 levels[6] = { 0, 95, 135, 175, 215, 255 };
+    index -= 16;
+
+    return sf::Color(levels[index / 36], levels[index / 6 % 6], levels[index % 6]);
+  }
+
+  sf::Uint8 gray = static_cast<sf::Uint8>(8 + (index - 232) * 10);
+  return sf::Color(gray, gray, gray);
+}
+
+} // namespace
+
+//=============================================================================
+//  void MarkupParser::parse()
+//-----------------------------------------------------------------------------
+void
+MarkupParser::parse(std::string_view input, const sf::Color& color)
+{
+  m_text.clear();
+  m_spans.clear();
+
+  // Most lines have no escapes and are copied as they are
+  size_t escape = input.find(ESCAPE);
+
+  if (escape == std::string_view::npos) {
+    m_text.assign(input);
+    return;
+  }
+
+  m_color = color;
+  m_colorIndex = -1;
+  m_isBold = false;
+  m_isUnderlined = false;
+  m_spans.push_back(TextSpan{ 0, color, false });
+
+  size_t begin = 0;
+
+  while (escape != std::string_view::npos) {
+    m_text.append(input.substr(begin, escape - begin));
+    begin = escape + 1;
+
+    if (begin >= input.size()) {
+      break;
+    }
+
+    // A control sequence runs from "ESC[" to a final byte, and only the ones
+    // ending in 'm' set the style. An operating system command, such as a
+    // window title, runs from "ESC]" to BEL or "ESC\". Any other escape ends
+    // at the first byte that is not an intermediate one, as in "ESC(B". An
+    // unterminated sequence hides the rest of the line.
+    if (input[begin] == '[') {
+      size_t end = begin + 1;
+
+      while (end < input.size() && (input[end] < 0x40 || input[end] > 0x7E)) {
+        end++;
+      }
+
+      if (end < input.size() && input[end] == 'm') {
+        applySgr(input.substr(begin + 1, end - begin - 1), color);
+      }
+
+      begin = std::min(end + 1, input.size());
+    }
+    else if (input[begin] == ']') {
+      size_t end = input.find_first_of("\a\033", begin + 1);
+
+      if (end != std::string_view::npos && input[end] == ESCAPE) {
+        end++;
+      }
+
+      begin = std::min(end, input.size() - 1) + 1;
+    }
+    else {
+      while (begin < input.size() && input[begin] >= 0x20 && input[begin] <= 0x2F) {
+        begin++;
+      }
+
+      begin = std::min(begin + 1, input.size());
+    }
+
+    escape = input.find(ESCAPE, begin);
+  }
+
+  m_text.append(input.substr(begin));
+
+  // A style set at the very end applies to nothing
+  if (m_spans.size() > 1 && m_spans.back().begin == m_text.size()) {
+    m_spans.pop_back();
+  }
+
+  if (m_spans.size() == 1 && m_spans[0].color == color && !m_spans[0].isUnderlined) {
+    m_spans.clear();
+  }
+}
+
+//=============================================================================
+//  void MarkupParser::applySgr()
+//-----------------------------------------------------------------------------
+void
+MarkupParser::applySgr(std::string_view parameters, const sf::Color& color)
+{
+  // Missing parameters are 0. Sequences with anything but digits and
+  // separators are private ones and are ignored.
+  m_parameters.clear();
+  int value = 0;
+
+  for (char c : parameters) {
+    if (c >= '0' && c <= '9') {
+      value = std::min(value * 10 + (c - '0'), 9999);
+    }
+    else if (c == ';' || c == ':') {
+      m_parameters.push_back(value);
+      value = 0;
+    }
+    else {
+      return;
+    }
+  }
+
+  m_parameters.push_back(value);
+
+  for (size_t i = 0; i < m_parameters.size(); ++i) {
+    int parameter = m_parameters[i];
+
+    if (parameter == 0) {
+      m_color = color;
+      m_colorIndex = -1;
+      m_isBold = false;
+      m_isUnderlined = false;
+    }
+    else if (parameter == 1) {
+      m_isBold = true;
+    }
+    else if (parameter == 22) {
+      m_isBold = false;
+    }
+    else if (parameter == 4) {
+      m_isUnderlined = true;
+    }
+    else if (parameter == 24) {
+      m_isUnderlined = false;
+    }
+    else if (parameter >= 30 && parameter <= 37) {
+      m_colorIndex = parameter - 30;
+    }
+    else if (parameter >= 90 && parameter <= 97) {
+      m_color = STANDARD_COLORS[parameter - 90 + 8];
+      m_colorIndex = -1;
+    }
+    else if (parameter == 39) {
+      m_color = color;
+      m_colorIndex = -1;
+    }
+    else if (parameter == 38 || parameter == 48) {
+      // Extended colors take two or four more parameters, which are skipped
+      // for a background color
+      sf::Color extended;
+      size_t nRemaining = m_parameters.size() - i - 1;
+
+      if (nRemaining >= 2 && m_parameters[i + 1] == 5) {
+        extended = getPaletteColor(std::min(m_parameters[i + 2], 255));
+        i += 2;
+      }
+      else if (nRemaining >= 4 && m_parameters[i + 1] == 2) {
+        extended = sf::Color(static_cast<sf::Uint8>(std::min(m_parameters[i + 2], 255)),
+                             static_cast<sf::Uint8>(std::min(m_parameters[i + 3], 255)),
+                             static_cast<sf::Uint8>(std::min(m_parameters[i + 4], 255)));
+        i += 4;
+      }
+      else {
+        break;
+      }
+
+      if (parameter == 38) {
+        m_color = extended;
+        m_colorIndex = -1;
+      }
+    }
+  }
+
+  beginSpan();
+}
+
+//=============================================================================
+//  void MarkupParser::beginSpan()
+//-----------------------------------------------------------------------------
+void
+MarkupParser::beginSpan()
+{
+  sf::Color color = m_colorIndex >= 0 ? STANDARD_COLORS[m_colorIndex + (m_isBold ? 8 : 0)] : m_color;
+  uint32_t begin = static_cast<uint32_t>(m_text.size());
+
+  TextSpan& last = m_spans.back();
+
+  if (last.color == color && last.isUnderlined == m_isUnderlined) {
+    return;
+  }
+
+  if (last.begin < begin) {
+    m_spans.push_back(TextSpan{ begin, color, m_isUnderlined });
+    return;
+  }
+
+  // Nothing was written in the last style, so it is replaced, and merged
+  // into the span before it if they now match
+  last.color = color;
+  last.isUnderlined = m_isUnderlined;
+
+  if (m_spans.size() > 1) {
+    const TextSpan& previous = m_spans[m_spans.size() - 2];
+
+    if (previous.color == color && previous.isUnderlined == m_isUnderlined) {
+      m_spans.pop_back();
+    }
+  }
+}
+
+} // namespace impl
+} // namespace sfmlConsole
@@ -0,0 +1,227 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "output-search.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace sfmlConsole {
+namespace impl {
+
+namespace {
+
+void
+toLower(std::string_view text, std::string& lowered)
+{
+  lowered.assign(text.data(), text.size());
+  for (char& c : lowered) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+}
+
+} // namespace
+
+//=============================================================================
+//  void OutputSearch::Scan::run()
+//-----------------------------------------------------------------------------
+void
+OutputSearch::Scan::run()
+{
+  const size_t nBlocks = blocks.size();
+
+  for (size_t i = 0; i < nBlocks; ++i) {
+    if ((i & 255) == 0 && isCancelled.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    isCandidate[i] = SearchIndex::mayContain(*blocks[nBlocks - 1 - i], trigrams);
+    nScanned.store(i + 1, std::memory_order_release);
+  }
+}
+
+//=============================================================================
+//  OutputSearch::OutputSearch()
+//-----------------------------------------------------------------------------
+OutputSearch::OutputSearch(size_t maxLines)
+  : m_index((maxLines + SearchIndex::BLOCK_LINES - 1) / SearchIndex::BLOCK_LINES)
+  , m_isRunning(false)
+  , m_firstLine(0)
+  , m_regionBegin(0)
+  , m_nextLine(0)
+  , m_nextBlock(0)
+  , m_scanner(1)
+{
+}
+
+OutputSearch::~OutputSearch()
+{
+  stop();
+}
+
+//=============================================================================
+//  void OutputSearch::clear()
+//-----------------------------------------------------------------------------
+void
+OutputSearch::clear(size_t nextLine)
+{
+  stop();
+  m_matches.clear();
+  m_index.clear(nextLine);
+}
+
+//=============================================================================
+//  void OutputSearch::start()
+//-----------------------------------------------------------------------------
+void
+OutputSearch::start(std::string_view pattern)
+{
+  stop();
+  m_matches.clear();
+
+  if (pattern.empty()) {
+    return;
+  }
+
+  toLower(pattern, m_pattern);
+
+  std::shared_ptr<Scan> scan = std::make_shared<Scan>();
+  scan->blocks = m_index.getCompletedBlocks();
+  SearchIndex::getTrigrams(m_pattern, scan->trigrams);
+  scan->isCandidate.resize(scan->blocks.size());
+  scan->nScanned.store(0, std::memory_order_relaxed);
+  scan->isCancelled.store(false, std::memory_order_relaxed);
+
+  // The lines after the completed blocks have no filter yet, so they are
+  // all checked, before any block since they are the newest
+  m_firstLine = m_index.getFirstLineNumber();
+  m_regionBegin = m_index.getCompletedEnd();
+  m_nextLine = m_index.getNextLineNumber();
+  m_nextBlock = 0;
+  m_isRunning = true;
+
+  m_scan = scan;
+  m_scanner.submit([scan] { scan->run(); });
+}
+
+//=============================================================================
+//  void OutputSearch::stop()
+//-----------------------------------------------------------------------------
+void
+OutputSearch::stop()
+{
+  if (m_scan) {
+    m_scan->isCancelled.store(true, std::memory_order_relaxed);
+    m_scan.reset();
+  }
+
+  m_isRunning = false;
+}
+
+//=============================================================================
+//  bool OutputSearch::update()
+//-----------------------------------------------------------------------------
+bool
+OutputSearch::update(const Scrollback& scrollback, size_t budget, size_t archivedBudget)
+{
+  if (!m_isRunning) {
+    return false;
+  }
+
+  const size_t nBlocks = m_scan->blocks.size();
+  const size_t nScanned = m_scan->nScanned.load(std::memory_order_acquire);
+  bool isChanged = false;
+
+  while (budget > 0) {
+    if (m_nextLine > m_regionBegin) {
+      // Archived lines are paged in from disk, so fewer of them are read
+      // per call
+      size_t line = m_nextLine - 1;
+      bool isArchived = line >= scrollback.getFirstLineNumber() &&
+                        line - scrollback.getFirstLineNumber() < scrollback.getArchivedCount();
+
+      if (isArchived) {
+        if (archivedBudget == 0) {
+          break;
+        }
+
+        archivedBudget--;
+      }
+
+      m_nextLine--;
+      budget--;
+
+      if (isMatch(scrollback, m_nextLine)) {
+        m_matches.push_back(m_nextLine);
+        isChanged = true;
+      }
+
+      continue;
+    }
+
+    if (m_nextBlock == nBlocks) {
+      // Every candidate has been checked
+      stop();
+      return true;
+    }
+
+    if (m_nextBlock == nScanned) {
+      // Wait for the worker to get further
+      break;
+    }
+
+    if (m_scan->isCandidate[m_nextBlock]) {
+      size_t block = nBlocks - 1 - m_nextBlock;
+      m_regionBegin = m_firstLine + block * SearchIndex::BLOCK_LINES;
+      m_nextLine = m_regionBegin + SearchIndex::BLOCK_LINES;
+    }
+
+    m_nextBlock++;
+  }
+
+  return isChanged;
+}
+
+//=============================================================================
+//  bool OutputSearch::isMatch()
+//-----------------------------------------------------------------------------
+bool
+OutputSearch::isMatch(const Scrollback& scrollback, size_t line)
+{
+  // The line may have left the scrollback since the search started
+  if (line < scrollback.getFirstLineNumber()) {
+    return false;
+  }
+
+  size_t index = line - scrollback.getFirstLineNumber();
+  if (index >= scrollback.size()) {
+    return false;
+  }
+
+  toLower(scrollback.at(index).text, m_lowered);
+
+  return m_lowered.find(m_pattern) != std::string::npos;
+}
+
+} // namespace impl
+} // namespace sfmlConsole
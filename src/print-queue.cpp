@@ -0,0 +1,97 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "print-queue.hpp"
+
+#include <cstdint>
+
+namespace sfmlConsole {
+namespace impl {
+
+const size_t PrintQueue::MESSAGE_RESERVE = 256;
+
+const size_t PrintQueue::SOURCE_RESERVE = 64;
+
+//=============================================================================
+//  PrintQueue::PrintQueue()
+//-----------------------------------------------------------------------------
+PrintQueue::PrintQueue(size_t capacity)
+  : m_enqueuePos(0)
+  , m_dequeuePos(0)
+  , m_dropped(0)
+{
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+
+  m_cells.reset(new Cell[size]);
+  m_mask = size - 1;
+
+  for (size_t i = 0; i < size; ++i) {
+    m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    m_cells[i].text.reserve(MESSAGE_RESERVE);
+    m_cells[i].source.reserve(SOURCE_RESERVE);
+  }
+}
+
+//=============================================================================
+//  bool PrintQueue::push()
+//-----------------------------------------------------------------------------
+bool
+PrintQueue::push(const std::string& msg, std::string_view source)
+{
+  size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+  Cell* cell;
+
+  for (;;) {
+    cell = &m_cells[pos & m_mask];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+    if (diff == 0) {
+      // The cell is free, try to claim it
+      if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    else if (diff < 0) {
+      // The consumer has not freed this cell yet, the queue is full
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    else {
+      // Another producer claimed the cell first
+      pos = m_enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  cell->text.assign(msg);
+  cell->source.assign(source);
+  cell->sequence.store(pos + 1, std::memory_order_release);
+
+  return true;
+}
+
+} // namespace impl
+} // namespace sfmlConsole
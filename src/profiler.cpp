@@ -0,0 +1,269 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace sfmlConsole {
+
+// Single-producer single-consumer ring of samples, written by one thread at a
+// time and read by collect()
+struct Profiler::ThreadBuffer
+{
+  struct Sample
+  {
+    const char* name;
+    float ms;
+  };
+
+  // Power of two, enough for a few hundred zones per frame
+  static const size_t CAPACITY = 1024;
+
+  ThreadBuffer()
+    : isOwned(true)
+    , head(0)
+    , tail(0)
+    , dropped(0)
+  {
+  }
+
+  Sample samples[CAPACITY];
+  std::atomic<bool> isOwned;
+
+  alignas(64) std::atomic<size_t> head;
+  alignas(64) std::atomic<size_t> tail;
+
+  std::atomic<size_t> dropped;
+};
+
+// Hands a thread's buffer back when the thread exits
+struct Profiler::BufferOwner
+{
+  ~BufferOwner()
+  {
+    if (buffer != nullptr) {
+      buffer->isOwned.store(false, std::memory_order_release);
+    }
+  }
+
+  ThreadBuffer* buffer = nullptr;
+};
+
+//=============================================================================
+//  Profiler::History::History()
+//-----------------------------------------------------------------------------
+Profiler::History::History()
+  : m_next(0)
+  , m_size(0)
+{
+}
+
+void
+Profiler::History::push(float ms)
+{
+  m_samples[m_next] = ms;
+  m_next = (m_next + 1) % CAPACITY;
+  m_size = std::min(m_size + 1, CAPACITY);
+}
+
+void
+Profiler::History::clear()
+{
+  m_next = 0;
+  m_size = 0;
+}
+
+float
+Profiler::History::mean() const
+{
+  if (m_size == 0) {
+    return 0;
+  }
+
+  float sum = 0;
+  for (size_t i = 0; i < m_size; ++i) {
+    sum += m_samples[i];
+  }
+
+  return sum / m_size;
+}
+
+float
+Profiler::History::percentile(float p) const
+{
+  if (m_size == 0) {
+    return 0;
+  }
+
+  std::vector<float> sorted(m_samples, m_samples + m_size);
+  size_t rank = std::min(static_cast<size_t>(p * m_size), m_size - 1);
+  std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+
+  return sorted[rank];
+}
+
+//=============================================================================
+//  Profiler::Profiler()
+//-----------------------------------------------------------------------------
+Profiler::Profiler()
+  : m_frameStart(Clock::now())
+{
+}
+
+Profiler&
+Profiler::instance()
+{
+  // Never destroyed, so that threads exiting during shutdown can still
+  // release their buffers
+  static Profiler* profiler = new Profiler();
+  return *profiler;
+}
+
+//=============================================================================
+//  void Profiler::record()
+//-----------------------------------------------------------------------------
+void
+Profiler::record(const char* name, Clock::time_point start, Clock::time_point end)
+{
+  static thread_local BufferOwner owner;
+
+  if (owner.buffer == nullptr) {
+    owner.buffer = acquireBuffer();
+  }
+
+  ThreadBuffer& buffer = *owner.buffer;
+  size_t head = buffer.head.load(std::memory_order_relaxed);
+
+  if (head - buffer.tail.load(std::memory_order_acquire) >= ThreadBuffer::CAPACITY) {
+    buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  ThreadBuffer::Sample& sample = buffer.samples[head & (ThreadBuffer::CAPACITY - 1)];
+  sample.name = name;
+  sample.ms = std::chrono::duration<float, std::milli>(end - start).count();
+
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+//=============================================================================
+//  ThreadBuffer* Profiler::acquireBuffer()
+//-----------------------------------------------------------------------------
+Profiler::ThreadBuffer*
+Profiler::acquireBuffer()
+{
+  std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+  for (ThreadBuffer* buffer : m_buffers) {
+    bool isOwned = false;
+    if (buffer->isOwned.compare_exchange_strong(isOwned, true, std::memory_order_acquire)) {
+      return buffer;
+    }
+  }
+
+  m_buffers.push_back(new ThreadBuffer());
+  return m_buffers.back();
+}
+
+//=============================================================================
+//  void Profiler::endFrame()
+//-----------------------------------------------------------------------------
+void
+Profiler::endFrame()
+{
+  Clock::time_point now = Clock::now();
+  m_frames.push(std::chrono::duration<float, std::milli>(now - m_frameStart).count());
+  m_frameStart = now;
+}
+
+//=============================================================================
+//  void Profiler::collect()
+//-----------------------------------------------------------------------------
+void
+Profiler::collect()
+{
+  std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+  for (ThreadBuffer* buffer : m_buffers) {
+    size_t tail = buffer->tail.load(std::memory_order_relaxed);
+    size_t head = buffer->head.load(std::memory_order_acquire);
+
+    // Zones are usually named by the same literal every time, so only look
+    // the name up again when it changes
+    const char* lastName = nullptr;
+    History* history = nullptr;
+
+    for (; tail != head; ++tail) {
+      const ThreadBuffer::Sample& sample = buffer->samples[tail & (ThreadBuffer::CAPACITY - 1)];
+
+      if (sample.name != lastName) {
+        lastName = sample.name;
+
+        std::string_view name(sample.name);
+        ZoneMap::iterator it = m_zones.find(name);
+        if (it == m_zones.end()) {
+          it = m_zones.emplace(std::string(name), History()).first;
+        }
+
+        history = &it->second;
+      }
+
+      history->push(sample.ms);
+    }
+
+    buffer->tail.store(tail, std::memory_order_release);
+  }
+}
+
+//=============================================================================
+//  void Profiler::reset()
+//-----------------------------------------------------------------------------
+void
+Profiler::reset()
+{
+  collect();
+
+  m_frames.clear();
+  m_zones.clear();
+  m_frameStart = Clock::now();
+}
+
+//=============================================================================
+//  size_t Profiler::takeDropped()
+//-----------------------------------------------------------------------------
+size_t
+Profiler::takeDropped()
+{
+  std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+  size_t dropped = 0;
+  for (ThreadBuffer* buffer : m_buffers) {
+    dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+  }
+
+  return dropped;
+}
+
+} // namespace sfmlConsole
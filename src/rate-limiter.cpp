@@ -0,0 +1,116 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "rate-limiter.hpp"
+
+#include <algorithm>
+
+namespace sfmlConsole {
+namespace impl {
+
+const RateLimiter::Clock::duration RateLimiter::QUIET_PERIOD = std::chrono::seconds(1);
+
+//=============================================================================
+//  RateLimiter::RateLimiter()
+//-----------------------------------------------------------------------------
+RateLimiter::RateLimiter()
+  : m_nDropping(0)
+{
+}
+
+//=============================================================================
+//  void RateLimiter::setLimit()
+//-----------------------------------------------------------------------------
+void
+RateLimiter::setLimit(std::string_view source, double linesPerSecond, size_t burst)
+{
+  auto it = m_buckets.find(source);
+
+  if (linesPerSecond <= 0) {
+    if (it != m_buckets.end()) {
+      if (it->second.nDropped > 0) {
+        m_nDropping--;
+      }
+
+      m_buckets.erase(it);
+    }
+
+    return;
+  }
+
+  double capacity = static_cast<double>(std::max<size_t>(burst, 1));
+
+  // A new source starts with a full bucket, and a new limit keeps what the
+  // bucket holds, within the new burst
+  if (it == m_buckets.end()) {
+    Bucket bucket = { linesPerSecond, capacity, capacity, Clock::now(), 0, Clock::time_point() };
+    m_buckets.emplace(std::string(source), bucket);
+    return;
+  }
+
+  Bucket& bucket = it->second;
+  bucket.linesPerSecond = linesPerSecond;
+  bucket.burst = capacity;
+  bucket.tokens = std::min(bucket.tokens, capacity);
+}
+
+//=============================================================================
+//  bool RateLimiter::admit()
+//-----------------------------------------------------------------------------
+bool
+RateLimiter::admit(std::string_view source)
+{
+  if (m_buckets.empty()) {
+    return true;
+  }
+
+  auto it = m_buckets.find(source);
+  if (it == m_buckets.end()) {
+    return true;
+  }
+
+  Bucket& bucket = it->second;
+  Clock::time_point now = Clock::now();
+
+  // Refill for the time since the last line, up to the burst
+  double elapsed = std::chrono::duration<double>(now - bucket.refilled).count();
+  bucket.tokens = std::min(bucket.burst, bucket.tokens + elapsed * bucket.linesPerSecond);
+  bucket.refilled = now;
+
+  if (bucket.tokens >= 1) {
+    bucket.tokens -= 1;
+    return true;
+  }
+
+  if (bucket.nDropped == 0) {
+    m_nDropping++;
+  }
+
+  bucket.nDropped++;
+  bucket.lastDropped = now;
+
+  return false;
+}
+
+} // namespace impl
+} // namespace sfmlConsole
@@ -0,0 +1,131 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "script-reader.hpp"
+
+#include <cstring>
+
+namespace sfmlConsole {
+namespace impl {
+
+const size_t SCRIPT_BUFFER_SIZE = 64 * 1024;
+
+//=============================================================================
+//  ScriptReader::ScriptReader()
+//-----------------------------------------------------------------------------
+ScriptReader::ScriptReader(const std::string& path)
+  : m_path(path)
+  , m_file(std::fopen(path.c_str(), "rb"))
+  , m_buffer(SCRIPT_BUFFER_SIZE)
+  , m_begin(0)
+  , m_end(0)
+  , m_lineNumber(0)
+{
+}
+
+//=============================================================================
+//  ScriptReader::~ScriptReader()
+//-----------------------------------------------------------------------------
+ScriptReader::~ScriptReader()
+{
+  if (m_file != nullptr) {
+    std::fclose(m_file);
+  }
+}
+
+//=============================================================================
+//  bool ScriptReader::fill()
+//-----------------------------------------------------------------------------
+bool
+ScriptReader::fill()
+{
+  if (m_file == nullptr) {
+    return false;
+  }
+
+  size_t remaining = m_end - m_begin;
+
+  // A single line longer than the buffer needs a bigger buffer
+  if (remaining == m_buffer.size()) {
+    m_buffer.resize(m_buffer.size() * 2);
+  }
+
+  std::memmove(m_buffer.data(), m_buffer.data() + m_begin, remaining);
+  m_begin = 0;
+  m_end = remaining;
+
+  size_t nRead = std::fread(m_buffer.data() + m_end, 1, m_buffer.size() - m_end, m_file);
+  m_end += nRead;
+
+  return nRead > 0;
+}
+
+//=============================================================================
+//  bool ScriptReader::nextLine()
+//-----------------------------------------------------------------------------
+bool
+ScriptReader::nextLine(std::string_view& line)
+{
+  for (;;) {
+    const char* begin = m_buffer.data() + m_begin;
+    const char* newline = static_cast<const char*>(std::memchr(begin, '\n', m_end - m_begin));
+    size_t length;
+
+    if (newline != nullptr) {
+      length = newline - begin;
+      m_begin += length + 1;
+    }
+    else if (fill()) {
+      continue;
+    }
+    else if (m_begin < m_end) {
+      // The last line has no line ending
+      begin = m_buffer.data() + m_begin;
+      length = m_end - m_begin;
+      m_begin = m_end;
+    }
+    else {
+      return false;
+    }
+
+    m_lineNumber++;
+
+    if (length > 0 && begin[length - 1] == '\r') {
+      length--;
+    }
+
+    line = std::string_view(begin, length);
+
+    // Skip blank lines and comments
+    size_t start = line.find_first_not_of(" \t");
+
+    if (start == std::string_view::npos || line[start] == '#' || line.compare(start, 2, "//") == 0) {
+      continue;
+    }
+
+    return true;
+  }
+}
+
+} // namespace impl
+} // namespace sfmlConsole
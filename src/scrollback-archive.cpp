@@ -0,0 +1,431 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "scrollback-archive.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+// The segments are unnamed temporary files read through mmap(), which
+// needs POSIX. Elsewhere they never open, so the scrollback only keeps the
+// lines that fit in memory.
+#if defined(__unix__) || defined(__APPLE__)
+#define SFML_CONSOLE_HAS_ARCHIVE
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace sfmlConsole {
+namespace impl {
+
+const size_t ScrollbackArchive::WRITE_BUFFER_SIZE = 64 * 1024;
+
+const size_t ScrollbackArchive::MAP_CHUNK_SIZE = 1024 * 1024;
+
+namespace {
+
+struct RecordHeader
+{
+  uint32_t color;
+  uint32_t length;
+  uint32_t nSpans;
+};
+
+struct SpanRecord
+{
+  uint32_t begin;
+  uint32_t color;
+  uint32_t isUnderlined;
+};
+
+} // namespace
+
+//=============================================================================
+//  ScrollbackArchive::ScrollbackArchive()
+//-----------------------------------------------------------------------------
+ScrollbackArchive::ScrollbackArchive(const std::string& directory)
+  : m_size(0)
+  , m_isOpen(false)
+{
+  m_isOpen = m_lines.open(directory) && m_index.open(directory);
+}
+
+//=============================================================================
+//  void ScrollbackArchive::append()
+//-----------------------------------------------------------------------------
+void
+ScrollbackArchive::append(std::string_view text, const sf::Color& color, const std::vector<TextSpan>& spans)
+{
+  if (!m_isOpen) {
+    return;
+  }
+
+  uint64_t offset = m_lines.size();
+  RecordHeader header = {
+    color.toInteger(), static_cast<uint32_t>(text.size()), static_cast<uint32_t>(spans.size())
+  };
+
+  if (!m_lines.append(&header, sizeof(header)) ||
+      !m_lines.append(text.data(), text.size())) {
+    fail();
+    return;
+  }
+
+  for (const TextSpan& span : spans) {
+    SpanRecord record = { span.begin, span.color.toInteger(), span.isUnderlined };
+
+    if (!m_lines.append(&record, sizeof(record))) {
+      fail();
+      return;
+    }
+  }
+
+  if (!m_index.append(&offset, sizeof(offset))) {
+    fail();
+    return;
+  }
+
+  m_size++;
+}
+
+//=============================================================================
+//  LineView ScrollbackArchive::at()
+//-----------------------------------------------------------------------------
+LineView
+ScrollbackArchive::at(size_t index) const
+{
+  LineView line = { std::string_view(), sf::Color::White, nullptr, 0 };
+
+  // Each read may move the mapped window, so copy the fixed-size fields out
+  // before reading the next part
+  const char* entry = m_index.read(index * sizeof(uint64_t), sizeof(uint64_t));
+  if (entry == nullptr) {
+    return line;
+  }
+
+  uint64_t offset;
+  std::memcpy(&offset, entry, sizeof(offset));
+
+  const char* record = m_lines.read(offset, sizeof(RecordHeader));
+  if (record == nullptr) {
+    return line;
+  }
+
+  RecordHeader header;
+  std::memcpy(&header, record, sizeof(header));
+
+  // The spans are read first, since reading the text last keeps it mapped
+  uint64_t spansOffset = offset + sizeof(header) + header.length;
+  m_spans.clear();
+
+  if (header.nSpans > 0) {
+    const char* spans = m_lines.read(spansOffset, header.nSpans * sizeof(SpanRecord));
+    if (spans == nullptr) {
+      return line;
+    }
+
+    for (uint32_t i = 0; i < header.nSpans; ++i) {
+      SpanRecord span;
+      std::memcpy(&span, spans + i * sizeof(SpanRecord), sizeof(span));
+      m_spans.push_back(TextSpan{ span.begin, sf::Color(span.color), span.isUnderlined != 0 });
+    }
+  }
+
+  const char* text = m_lines.read(offset + sizeof(header), header.length);
+  if (text != nullptr) {
+    line.text = std::string_view(text, header.length);
+    line.color = sf::Color(header.color);
+    line.spans = m_spans.data();
+    line.nSpans = m_spans.size();
+  }
+
+  return line;
+}
+
+//=============================================================================
+//  void ScrollbackArchive::clear()
+//-----------------------------------------------------------------------------
+void
+ScrollbackArchive::clear()
+{
+  m_size = 0;
+
+  if (m_isOpen && !(m_lines.truncate() && m_index.truncate())) {
+    m_isOpen = false;
+  }
+}
+
+//=============================================================================
+//  void ScrollbackArchive::fail()
+//-----------------------------------------------------------------------------
+void
+ScrollbackArchive::fail()
+{
+  // A partly written record would leave the index out of step with the
+  // segment, so drop everything rather than risk showing the wrong lines
+  m_lines.truncate();
+  m_index.truncate();
+  m_size = 0;
+  m_isOpen = false;
+}
+
+#ifdef SFML_CONSOLE_HAS_ARCHIVE
+
+//=============================================================================
+//  ScrollbackArchive::Segment::Segment()
+//-----------------------------------------------------------------------------
+ScrollbackArchive::Segment::Segment()
+  : m_fd(-1)
+  , m_fileSize(0)
+  , m_map(nullptr)
+  , m_mapOffset(0)
+  , m_mapLength(0)
+{
+}
+
+ScrollbackArchive::Segment::~Segment()
+{
+  unmap();
+
+  if (m_fd >= 0) {
+    ::close(m_fd);
+  }
+}
+
+//=============================================================================
+//  bool ScrollbackArchive::Segment::open()
+//-----------------------------------------------------------------------------
+bool
+ScrollbackArchive::Segment::open(const std::string& directory)
+{
+  std::string path = directory + "/sfml-console-scrollback-XXXXXX";
+  std::vector<char> name(path.begin(), path.end());
+  name.push_back('\0');
+
+  m_fd = ::mkstemp(name.data());
+  if (m_fd < 0) {
+    return false;
+  }
+
+  // Only the descriptor is needed, and the file goes away with it
+  ::unlink(name.data());
+
+  m_buffer.reserve(WRITE_BUFFER_SIZE);
+
+  return true;
+}
+
+//=============================================================================
+//  bool ScrollbackArchive::Segment::append()
+//-----------------------------------------------------------------------------
+bool
+ScrollbackArchive::Segment::append(const void* data, size_t length)
+{
+  const char* bytes = static_cast<const char*>(data);
+
+  if (m_buffer.size() + length > WRITE_BUFFER_SIZE) {
+    if (!flush()) {
+      return false;
+    }
+
+    // Lines longer than the buffer skip it
+    if (length > WRITE_BUFFER_SIZE) {
+      return writeAll(bytes, length);
+    }
+  }
+
+  m_buffer.insert(m_buffer.end(), bytes, bytes + length);
+
+  return true;
+}
+
+//=============================================================================
+//  const char* ScrollbackArchive::Segment::read()
+//-----------------------------------------------------------------------------
+const char*
+ScrollbackArchive::Segment::read(uint64_t offset, size_t length)
+{
+  if (length == 0) {
+    return "";
+  }
+
+  if (offset + length > size()) {
+    return nullptr;
+  }
+
+  // Bytes still in the write buffer have to reach the file to be mapped
+  if (offset + length > m_fileSize && !flush()) {
+    return nullptr;
+  }
+
+  if (m_map == nullptr || offset < m_mapOffset || offset + length > m_mapOffset + m_mapLength) {
+    unmap();
+
+    // Map whole chunks around the range, plus one more so that reading the
+    // following lines does not map again right away
+    uint64_t begin = offset / MAP_CHUNK_SIZE * MAP_CHUNK_SIZE;
+    uint64_t end = (offset + length + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE * MAP_CHUNK_SIZE + MAP_CHUNK_SIZE;
+    end = std::min(end, m_fileSize);
+
+    void* map = ::mmap(nullptr, end - begin, PROT_READ, MAP_SHARED, m_fd, static_cast<off_t>(begin));
+    if (map == MAP_FAILED) {
+      return nullptr;
+    }
+
+    m_map = static_cast<char*>(map);
+    m_mapOffset = begin;
+    m_mapLength = end - begin;
+  }
+
+  return m_map + (offset - m_mapOffset);
+}
+
+//=============================================================================
+//  bool ScrollbackArchive::Segment::truncate()
+//-----------------------------------------------------------------------------
+bool
+ScrollbackArchive::Segment::truncate()
+{
+  unmap();
+  m_buffer.clear();
+  m_fileSize = 0;
+
+  return m_fd >= 0 && ::ftruncate(m_fd, 0) == 0 && ::lseek(m_fd, 0, SEEK_SET) == 0;
+}
+
+//=============================================================================
+//  bool ScrollbackArchive::Segment::flush()
+//-----------------------------------------------------------------------------
+bool
+ScrollbackArchive::Segment::flush()
+{
+  if (m_buffer.empty()) {
+    return true;
+  }
+
+  bool isWritten = writeAll(m_buffer.data(), m_buffer.size());
+  m_buffer.clear();
+
+  return isWritten;
+}
+
+//=============================================================================
+//  bool ScrollbackArchive::Segment::writeAll()
+//-----------------------------------------------------------------------------
+bool
+ScrollbackArchive::Segment::writeAll(const char* data, size_t length)
+{
+  while (length > 0) {
+    ssize_t written = ::write(m_fd, data, length);
+
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return false;
+    }
+
+    data += written;
+    length -= static_cast<size_t>(written);
+    m_fileSize += static_cast<uint64_t>(written);
+  }
+
+  return true;
+}
+
+//=============================================================================
+//  void ScrollbackArchive::Segment::unmap()
+//-----------------------------------------------------------------------------
+void
+ScrollbackArchive::Segment::unmap()
+{
+  if (m_map != nullptr) {
+    ::munmap(m_map, m_mapLength);
+    m_map = nullptr;
+    m_mapLength = 0;
+  }
+}
+
+#else
+
+//=============================================================================
+//  ScrollbackArchive::Segment::Segment()
+//-----------------------------------------------------------------------------
+ScrollbackArchive::Segment::Segment()
+  : m_fd(-1)
+  , m_fileSize(0)
+  , m_map(nullptr)
+  , m_mapOffset(0)
+  , m_mapLength(0)
+{
+}
+
+ScrollbackArchive::Segment::~Segment()
+{
+}
+
+//=============================================================================
+//  bool ScrollbackArchive::Segment::open()
+//-----------------------------------------------------------------------------
+bool
+ScrollbackArchive::Segment::open(const std::string&)
+{
+  return false;
+}
+
+//=============================================================================
+//  bool ScrollbackArchive::Segment::append()
+//-----------------------------------------------------------------------------
+bool
+ScrollbackArchive::Segment::append(const void*, size_t)
+{
+  return false;
+}
+
+//=============================================================================
+//  const char* ScrollbackArchive::Segment::read()
+//-----------------------------------------------------------------------------
+const char*
+ScrollbackArchive::Segment::read(uint64_t, size_t)
+{
+  return nullptr;
+}
+
+//=============================================================================
+//  bool ScrollbackArchive::Segment::truncate()
+//-----------------------------------------------------------------------------
+bool
+ScrollbackArchive::Segment::truncate()
+{
+  return false;
+}
+
+#endif // SFML_CONSOLE_HAS_ARCHIVE
+
+} // namespace impl
+} // namespace sfmlConsole
@@ -0,0 +1,97 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "scrollback.hpp"
+
+#include <algorithm>
+
+namespace sfmlConsole {
+namespace impl {
+
+//=============================================================================
+//  Scrollback::Scrollback()
+//-----------------------------------------------------------------------------
+Scrollback::Scrollback(size_t capacity, const std::string& archiveDirectory)
+  : m_lines(std::max<size_t>(capacity, 1))
+  , m_begin(0)
+  , m_size(0)
+  , m_nRemoved(0)
+{
+  if (!archiveDirectory.empty()) {
+    m_archive.reset(new ScrollbackArchive(archiveDirectory));
+  }
+}
+
+//=============================================================================
+//  void Scrollback::push()
+//-----------------------------------------------------------------------------
+void
+Scrollback::push(std::string_view text, const sf::Color& color, const std::vector<TextSpan>& spans)
+{
+  size_t slot = (m_begin + m_size) % m_lines.size();
+
+  if (m_size == m_lines.size()) {
+    // Buffer is full, overwrite the oldest line once it is archived
+    if (hasArchive()) {
+      size_t nArchived = m_archive->size();
+      m_archive->append(m_lines[slot].text, m_lines[slot].color, m_lines[slot].spans);
+
+      // A failed archive loses every line it held
+      if (!m_archive->isOpen()) {
+        m_nRemoved += nArchived + 1;
+      }
+    }
+    else {
+      m_nRemoved++;
+    }
+
+    m_begin = (m_begin + 1) % m_lines.size();
+  }
+  else {
+    m_size++;
+  }
+
+  // assign() reuses the slot's existing storage when it is large enough
+  m_lines[slot].text.assign(text);
+  m_lines[slot].color = color;
+  m_lines[slot].spans.assign(spans.begin(), spans.end());
+}
+
+//=============================================================================
+//  void Scrollback::clear()
+//-----------------------------------------------------------------------------
+void
+Scrollback::clear()
+{
+  // Keep the slots' string storage around so the buffer stays warm
+  m_nRemoved += size();
+  m_begin = 0;
+  m_size = 0;
+
+  if (m_archive) {
+    m_archive->clear();
+  }
+}
+
+} // namespace impl
+} // namespace sfmlConsole
@@ -0,0 +1,149 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "search-index.hpp"
+
+#include <cctype>
+
+namespace sfmlConsole {
+namespace impl {
+
+namespace {
+
+inline uint32_t
+hashTrigram(const char* c)
+{
+  uint32_t trigram = static_cast<uint32_t>(std::tolower(static_cast<unsigned char>(c[0]))) |
+                     static_cast<uint32_t>(std::tolower(static_cast<unsigned char>(c[1]))) << 8 |
+                     static_cast<uint32_t>(std::tolower(static_cast<unsigned char>(c[2]))) << 16;
+
+  return trigram * 0x9E3779B1u;
+}
+
+// Two bits per trigram, taken from different parts of the hash
+inline size_t
+firstBit(uint32_t hash)
+{
+  return hash >> 19;
+}
+
+inline size_t
+secondBit(uint32_t hash)
+{
+  return (hash >> 6) & (SearchIndex::FILTER_BITS - 1);
+}
+
+} // namespace
+
+//=============================================================================
+//  SearchIndex::SearchIndex()
+//-----------------------------------------------------------------------------
+SearchIndex::SearchIndex(size_t maxBlocks)
+  : m_maxBlocks(maxBlocks)
+  , m_firstLine(0)
+  , m_current(std::make_shared<Filter>())
+  , m_nCurrentLines(0)
+{
+  static_assert(FILTER_BITS == 1 << 13, "firstBit() takes the top 13 bits of a hash");
+}
+
+//=============================================================================
+//  void SearchIndex::add()
+//-----------------------------------------------------------------------------
+void
+SearchIndex::add(std::string_view line)
+{
+  Filter& filter = *m_current;
+
+  for (size_t i = 0; i + 3 <= line.size(); ++i) {
+    uint32_t hash = hashTrigram(line.data() + i);
+    filter.set(firstBit(hash));
+    filter.set(secondBit(hash));
+  }
+
+  if (++m_nCurrentLines == BLOCK_LINES) {
+    m_blocks.push_back(std::move(m_current));
+    m_current = std::make_shared<Filter>();
+    m_nCurrentLines = 0;
+
+    if (m_blocks.size() > m_maxBlocks) {
+      m_blocks.pop_front();
+      m_firstLine += BLOCK_LINES;
+    }
+  }
+}
+
+//=============================================================================
+//  void SearchIndex::discardBefore()
+//-----------------------------------------------------------------------------
+void
+SearchIndex::discardBefore(size_t lineNumber)
+{
+  while (!m_blocks.empty() && m_firstLine + BLOCK_LINES <= lineNumber) {
+    m_blocks.pop_front();
+    m_firstLine += BLOCK_LINES;
+  }
+}
+
+//=============================================================================
+//  void SearchIndex::clear()
+//-----------------------------------------------------------------------------
+void
+SearchIndex::clear(size_t nextLineNumber)
+{
+  m_blocks.clear();
+  m_firstLine = nextLineNumber;
+
+  // A search may still hold the old filter
+  m_current = std::make_shared<Filter>();
+  m_nCurrentLines = 0;
+}
+
+//=============================================================================
+//  void SearchIndex::getTrigrams()
+//-----------------------------------------------------------------------------
+void
+SearchIndex::getTrigrams(std::string_view text, std::vector<uint32_t>& hashes)
+{
+  for (size_t i = 0; i + 3 <= text.size(); ++i) {
+    hashes.push_back(hashTrigram(text.data() + i));
+  }
+}
+
+//=============================================================================
+//  bool SearchIndex::mayContain()
+//-----------------------------------------------------------------------------
+bool
+SearchIndex::mayContain(const Filter& filter, const std::vector<uint32_t>& hashes)
+{
+  for (uint32_t hash : hashes) {
+    if (!filter.test(firstBit(hash)) || !filter.test(secondBit(hash))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace impl
+} // namespace sfmlConsole
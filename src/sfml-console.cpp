@@ -32,6 +32,11 @@ SfmlConsole::SfmlConsole(const sf::RenderWindow& window, const sf::Font& font)
 {
 }
 
+SfmlConsole::SfmlConsole(const sf::RenderWindow& window, const sf::Font& font, const Style& style)
+  : m_impl(new impl::Console(window, font, style))
+{
+}
+
 void
 SfmlConsole::handleEvent(const sf::Event& event)
 {
@@ -68,24 +73,78 @@ SfmlConsole::isVisible() const
   return m_impl->isVisible();
 }
 
+void
+SfmlConsole::prewarm()
+{
+  m_impl->prewarm();
+}
+
 void
 SfmlConsole::print(const std::string& msg)
 {
   m_impl->print(msg);
 }
 
+void
+SfmlConsole::print(const std::string& source, const std::string& msg)
+{
+  m_impl->print(source, msg);
+}
+
+void
+SfmlConsole::setRateLimit(const std::string& source, double linesPerSecond, size_t burst)
+{
+  m_impl->setRateLimit(source, linesPerSecond, burst);
+}
+
 void
 SfmlConsole::clearHistory()
 {
   m_impl->clearHistory();
 }
 
+bool
+SfmlConsole::exec(const std::string& path)
+{
+  return m_impl->exec(path);
+}
+
+bool
+SfmlConsole::openLog(const std::string& path, size_t maxFileSize, size_t maxFiles)
+{
+  return m_impl->openLog(path, maxFileSize, maxFiles);
+}
+
+void
+SfmlConsole::closeLog()
+{
+  m_impl->closeLog();
+}
+
+bool
+SfmlConsole::openHistory(const std::string& path, size_t capacity)
+{
+  return m_impl->openHistory(path, capacity);
+}
+
 bool
 SfmlConsole::registerCommand(const std::string& name, const Command& command)
 {
   return m_impl->registerCommand(name, command);
 }
 
+bool
+SfmlConsole::registerCommand(const std::string& name, const CommandView& command)
+{
+  return m_impl->registerCommand(name, command);
+}
+
+bool
+SfmlConsole::registerAsyncCommand(const std::string& name, const AsyncCommand& command)
+{
+  return m_impl->registerAsyncCommand(name, command);
+}
+
 bool
 SfmlConsole::unregisterCommand(const std::string& name)
 {
@@ -98,6 +157,48 @@ SfmlConsole::isCommand(const std::string& name) const
   return m_impl->isCommand(name);
 }
 
+CommandHandle
+SfmlConsole::findCommand(std::string_view name) const
+{
+  return m_impl->findCommand(name);
+}
+
+bool
+SfmlConsole::invokeCommand(CommandHandle handle, const CommandParameterViews& params)
+{
+  return m_impl->invokeCommand(handle, params);
+}
+
+IntCvar*
+SfmlConsole::registerIntCvar(const std::string& name, int value, const std::string& description)
+{
+  return m_impl->registerIntCvar(name, value, description);
+}
+
+FloatCvar*
+SfmlConsole::registerFloatCvar(const std::string& name, float value, const std::string& description)
+{
+  return m_impl->registerFloatCvar(name, value, description);
+}
+
+BoolCvar*
+SfmlConsole::registerBoolCvar(const std::string& name, bool value, const std::string& description)
+{
+  return m_impl->registerBoolCvar(name, value, description);
+}
+
+StringCvar*
+SfmlConsole::registerStringCvar(const std::string& name, std::string_view value, const std::string& description)
+{
+  return m_impl->registerStringCvar(name, value, description);
+}
+
+CvarBase*
+SfmlConsole::findCvar(std::string_view name) const
+{
+  return m_impl->findCvar(name);
+}
+
 void
 SfmlConsole::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
@@ -25,6 +25,10 @@
 
 namespace sfmlConsole {
 
+const size_t Style::DEFAULT_SCROLLBACK_SIZE = 1000;
+
+const size_t Style::DEFAULT_SCRIPT_LINES_PER_FRAME = 1000;
+
 const Style Style::Default(16, 0.50, 4, '>', '_', sf::Color::White, sf::Color::Blue, sf::Color::White);
 
 //=============================================================================
@@ -37,7 +41,8 @@ Style::Style(size_t fontSize,
              char cursorCharacter,
              sf::Color borderColor,
              sf::Color backgroundColor,
-             sf::Color fontColor)
+             sf::Color fontColor,
+             size_t scrollbackSize)
   : m_fontSize(fontSize)
   , m_heightPercentage(heightPercentage)
   , m_marginSize(marginSize)
@@ -46,6 +51,10 @@ Style::Style(size_t fontSize,
   , m_borderColor(borderColor)
   , m_backgroundColor(backgroundColor)
   , m_fontColor(fontColor)
+  , m_scrollbackSize(scrollbackSize)
+  , m_scriptLinesPerFrame(DEFAULT_SCRIPT_LINES_PER_FRAME)
+  , m_isPrewarmingGlyphs(true)
+  , m_fontSpacing(FontSpacing::DETECT)
 {
 }
 
@@ -0,0 +1,399 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "text-batch.hpp"
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sfmlConsole {
+namespace impl {
+
+// Texel inside the white square SFML reserves in each font page
+const sf::Vector2f WHITE_TEXEL(1, 1);
+
+const int TextBatch::TAB_WIDTH = 4;
+
+//=============================================================================
+//  TextBatch::TextBatch()
+//-----------------------------------------------------------------------------
+TextBatch::TextBatch(const sf::Font& font, unsigned int characterSize)
+  : m_font(font)
+  , m_characterSize(characterSize)
+  , m_isMonospace(false)
+  , m_advance(0)
+  , m_glyphs()
+  , m_clipTop(-std::numeric_limits<float>::infinity())
+  , m_clipBottom(std::numeric_limits<float>::infinity())
+  , m_vertices(sf::Quads)
+{
+}
+
+//=============================================================================
+//  void TextBatch::setCharacterSize()
+//-----------------------------------------------------------------------------
+void
+TextBatch::setCharacterSize(unsigned int characterSize)
+{
+  if (characterSize == m_characterSize) {
+    return;
+  }
+
+  m_characterSize = characterSize;
+
+  // Glyphs are looked up again at the new size
+  setMonospace(m_isMonospace);
+}
+
+//=============================================================================
+//  void TextBatch::setMonospace()
+//-----------------------------------------------------------------------------
+void
+TextBatch::setMonospace(bool isMonospace)
+{
+  m_isMonospace = isMonospace;
+  m_advance = isMonospace ? m_font.getGlyph(' ', m_characterSize, false).advance : 0;
+
+  for (GlyphQuad& glyph : m_glyphs) {
+    glyph.isLoaded = false;
+  }
+}
+
+//=============================================================================
+//  void TextBatch::clear()
+//-----------------------------------------------------------------------------
+void
+TextBatch::clear()
+{
+  m_vertices.clear();
+}
+
+//=============================================================================
+//  void TextBatch::setClip()
+//-----------------------------------------------------------------------------
+void
+TextBatch::setClip(float top, float bottom)
+{
+  m_clipTop = top;
+  m_clipBottom = bottom;
+}
+
+//=============================================================================
+//  void TextBatch::resetClip()
+//-----------------------------------------------------------------------------
+void
+TextBatch::resetClip()
+{
+  m_clipTop = -std::numeric_limits<float>::infinity();
+  m_clipBottom = std::numeric_limits<float>::infinity();
+}
+
+//=============================================================================
+//  void TextBatch::addRect()
+//-----------------------------------------------------------------------------
+void
+TextBatch::addRect(const sf::FloatRect& rect, const sf::Color& color)
+{
+  addQuad(rect.left, rect.top, rect.left + rect.width, rect.top + rect.height, color,
+          WHITE_TEXEL.x, WHITE_TEXEL.y, WHITE_TEXEL.x, WHITE_TEXEL.y);
+}
+
+//=============================================================================
+//  void TextBatch::addQuad()
+//-----------------------------------------------------------------------------
+void
+TextBatch::addQuad(float left, float top, float right, float bottom, const sf::Color& color,
+                   float u1, float v1, float u2, float v2)
+{
+  size_t count = m_vertices.getVertexCount();
+  m_vertices.resize(count + 4);
+
+  if (!writeQuad(&m_vertices[count], left, top, right, bottom, color, u1, v1, u2, v2)) {
+    m_vertices.resize(count);
+  }
+}
+
+//=============================================================================
+//  bool TextBatch::writeQuad()
+//-----------------------------------------------------------------------------
+bool
+TextBatch::writeQuad(sf::Vertex* quad, float left, float top, float right, float bottom, const sf::Color& color,
+                     float u1, float v1, float u2, float v2) const
+{
+  if (bottom <= m_clipTop || top >= m_clipBottom) {
+    return false;
+  }
+
+  // Cut the texture by as much as the quad
+  float texelsPerPixel = bottom > top ? (v2 - v1) / (bottom - top) : 0;
+
+  if (top < m_clipTop) {
+    v1 += (m_clipTop - top) * texelsPerPixel;
+    top = m_clipTop;
+  }
+
+  if (bottom > m_clipBottom) {
+    v2 -= (bottom - m_clipBottom) * texelsPerPixel;
+    bottom = m_clipBottom;
+  }
+
+  quad[0] = sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(u1, v1));
+  quad[1] = sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1));
+  quad[2] = sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u2, v2));
+  quad[3] = sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2));
+
+  return true;
+}
+
+//=============================================================================
+//  float TextBatch::addText()
+//-----------------------------------------------------------------------------
+float
+TextBatch::addText(const std::string& text, float x, float y, const sf::Color& color)
+{
+  return addText(text.data(), text.data() + text.size(), x, y, color);
+}
+
+float
+TextBatch::addText(const char* begin, const char* end, float x, float y, const sf::Color& color, uint32_t previous)
+{
+  if (m_isMonospace) {
+    return addMonospaceText(begin, end, x, y, color);
+  }
+
+  // Same baseline as sf::Text, which starts one character size below the top
+  float baseline = y + m_characterSize;
+  float spaceAdvance = m_font.getGlyph(' ', m_characterSize, false).advance;
+
+  for (const char* it = begin; it != end; ++it) {
+    uint32_t current = static_cast<unsigned char>(*it);
+
+    x += m_font.getKerning(previous, current, m_characterSize);
+    previous = current;
+
+    if (current == ' ') {
+      x += spaceAdvance;
+      continue;
+    }
+    else if (current == '\t') {
+      x += spaceAdvance * TAB_WIDTH;
+      continue;
+    }
+    else if (current == '\n' || current == '\r') {
+      continue;
+    }
+
+    const sf::Glyph& glyph = m_font.getGlyph(current, m_characterSize, false);
+
+    float left = x + glyph.bounds.left;
+    float top = baseline + glyph.bounds.top;
+    float right = left + glyph.bounds.width;
+    float bottom = top + glyph.bounds.height;
+
+    float u1 = static_cast<float>(glyph.textureRect.left);
+    float v1 = static_cast<float>(glyph.textureRect.top);
+    float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+    float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height);
+
+    addQuad(left, top, right, bottom, color, u1, v1, u2, v2);
+
+    x += glyph.advance;
+  }
+
+  return x;
+}
+
+//=============================================================================
+//  float TextBatch::addMonospaceText()
+//-----------------------------------------------------------------------------
+float
+TextBatch::addMonospaceText(const char* begin, const char* end, float x, float y, const sf::Color& color)
+{
+  if (begin == end) {
+    return x;
+  }
+
+  // Make room for a quad per byte and give back what blanks and clipping
+  // did not use
+  size_t first = m_vertices.getVertexCount();
+  m_vertices.resize(first + 4 * (end - begin));
+
+  sf::Vertex* quad = &m_vertices[first];
+  float baseline = y + m_characterSize;
+
+  for (const char* it = begin; it != end; ++it) {
+    unsigned char c = static_cast<unsigned char>(*it);
+
+    if (c == ' ') {
+      x += m_advance;
+      continue;
+    }
+    else if (c == '\t') {
+      x += m_advance * TAB_WIDTH;
+      continue;
+    }
+    else if (c == '\n' || c == '\r') {
+      continue;
+    }
+
+    const GlyphQuad& glyph = getGlyphQuad(c);
+
+    if (writeQuad(quad, x + glyph.left, baseline + glyph.top, x + glyph.right, baseline + glyph.bottom, color,
+                  glyph.u1, glyph.v1, glyph.u2, glyph.v2)) {
+      quad += 4;
+    }
+
+    x += m_advance;
+  }
+
+  m_vertices.resize(first + (quad - &m_vertices[first]));
+
+  return x;
+}
+
+//=============================================================================
+//  const GlyphQuad& TextBatch::getGlyphQuad()
+//-----------------------------------------------------------------------------
+const TextBatch::GlyphQuad&
+TextBatch::getGlyphQuad(unsigned char c)
+{
+  GlyphQuad& quad = m_glyphs[c];
+
+  // Rectangles in the font's texture stay where they are when it grows
+  if (!quad.isLoaded) {
+    const sf::Glyph& glyph = m_font.getGlyph(c, m_characterSize, false);
+
+    quad.isLoaded = true;
+    quad.left = glyph.bounds.left;
+    quad.top = glyph.bounds.top;
+    quad.right = glyph.bounds.left + glyph.bounds.width;
+    quad.bottom = glyph.bounds.top + glyph.bounds.height;
+    quad.u1 = static_cast<float>(glyph.textureRect.left);
+    quad.v1 = static_cast<float>(glyph.textureRect.top);
+    quad.u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+    quad.v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height);
+  }
+
+  return quad;
+}
+
+//=============================================================================
+//  float TextBatch::addSpans()
+//-----------------------------------------------------------------------------
+float
+TextBatch::addSpans(std::string_view text, uint32_t begin, uint32_t end, const TextSpan* spans, size_t nSpans,
+                    float x, float y)
+{
+  // Start from the last span that begins at or before begin
+  const TextSpan* span = std::upper_bound(spans, spans + nSpans, begin, [] (uint32_t index, const TextSpan& s) {
+    return index < s.begin;
+  });
+
+  if (span != spans) {
+    span--;
+  }
+
+  float baseline = y + m_characterSize;
+  float underlineTop = std::floor(baseline + m_font.getUnderlinePosition(m_characterSize) -
+                                  m_font.getUnderlineThickness(m_characterSize) / 2 + 0.5f);
+  float underlineHeight = std::floor(m_font.getUnderlineThickness(m_characterSize) + 0.5f);
+
+  for (uint32_t position = begin; position < end; ++span) {
+    uint32_t spanEnd = span + 1 < spans + nSpans ? std::min(span[1].begin, end) : end;
+    // A row starts without kerning, as plain rows and the wrap cache do
+    uint32_t previous = position > begin ? static_cast<unsigned char>(text[position - 1]) : 0;
+
+    float left = x;
+    x = addText(text.data() + position, text.data() + spanEnd, x, y, span->color, previous);
+
+    if (span->isUnderlined) {
+      addRect(sf::FloatRect(left, underlineTop, x - left, underlineHeight), span->color);
+    }
+
+    position = spanEnd;
+  }
+
+  return x;
+}
+
+//=============================================================================
+//  float TextBatch::measure()
+//-----------------------------------------------------------------------------
+float
+TextBatch::measure(const std::string& text, size_t count) const
+{
+  float x = 0;
+  uint32_t previous = 0;
+
+  if (m_isMonospace) {
+    for (size_t i = 0; i < count && i < text.size(); ++i) {
+      if (text[i] == '\t') {
+        x += m_advance * TAB_WIDTH;
+      }
+      else if (text[i] != '\n' && text[i] != '\r') {
+        x += m_advance;
+      }
+    }
+
+    return x;
+  }
+
+  for (size_t i = 0; i < count && i < text.size(); ++i) {
+    uint32_t current = static_cast<unsigned char>(text[i]);
+
+    x += m_font.getKerning(previous, current, m_characterSize);
+    previous = current;
+
+    if (current == '\t') {
+      x += m_font.getGlyph(' ', m_characterSize, false).advance * TAB_WIDTH;
+    }
+    else if (current != '\n' && current != '\r') {
+      x += m_font.getGlyph(current, m_characterSize, false).advance;
+    }
+  }
+
+  return x;
+}
+
+//=============================================================================
+//  void TextBatch::draw()
+//-----------------------------------------------------------------------------
+void
+TextBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+  if (m_vertices.getVertexCount() == 0) {
+    return;
+  }
+
+  // The page texture is looked up last since laying out new glyphs may have
+  // grown it
+  states.texture = &m_font.getTexture(m_characterSize);
+  target.draw(m_vertices, states);
+}
+
+} // namespace impl
+} // namespace sfmlConsole
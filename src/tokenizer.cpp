@@ -0,0 +1,120 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "tokenizer.hpp"
+
+namespace sfmlConsole {
+namespace impl {
+
+//=============================================================================
+//  bool isSpace()
+//-----------------------------------------------------------------------------
+static bool
+isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+//=============================================================================
+//  char unescape()
+//-----------------------------------------------------------------------------
+static char
+unescape(char c)
+{
+  switch (c) {
+    case 'n':
+      return '\n';
+    case 't':
+      return '\t';
+    default:
+      return c;
+  }
+}
+
+//=============================================================================
+//  const Tokens& Tokenizer::tokenize()
+//-----------------------------------------------------------------------------
+const Tokenizer::Tokens&
+Tokenizer::tokenize(std::string_view input)
+{
+  m_tokens.clear();
+
+  // Unescaped text is never longer than the input, so reserving up front
+  // guarantees the views below are not invalidated by a reallocation
+  m_buffer.clear();
+  m_buffer.reserve(input.size());
+
+  const char* it = input.data();
+  const char* end = it + input.size();
+
+  while (it != end) {
+    if (isSpace(*it)) {
+      ++it;
+      continue;
+    }
+
+    size_t begin = m_buffer.size();
+    char quote = 0;
+
+    for (; it != end; ++it) {
+      char c = *it;
+
+      if (quote == '\'') {
+        if (c == '\'') {
+          quote = 0;
+        }
+        else {
+          m_buffer.push_back(c);
+        }
+      }
+      else if (c == '\\' && it + 1 != end) {
+        m_buffer.push_back(unescape(*++it));
+      }
+      else if (quote == '"') {
+        if (c == '"') {
+          quote = 0;
+        }
+        else {
+          m_buffer.push_back(c);
+        }
+      }
+      else if (c == '"' || c == '\'') {
+        quote = c;
+      }
+      else if (isSpace(c)) {
+        break;
+      }
+      else {
+        m_buffer.push_back(c);
+      }
+    }
+
+    // An unterminated quote extends to the end of the input
+    m_tokens.emplace_back(m_buffer.data() + begin, m_buffer.size() - begin);
+  }
+
+  return m_tokens;
+}
+
+} // namespace impl
+} // namespace sfmlConsole
@@ -0,0 +1,102 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "worker-pool.hpp"
+
+namespace sfmlConsole {
+namespace impl {
+
+//=============================================================================
+//  WorkerPool::WorkerPool()
+//-----------------------------------------------------------------------------
+WorkerPool::WorkerPool(size_t nThreads)
+  : m_nThreads(nThreads)
+  , m_isStopping(false)
+{
+}
+
+//=============================================================================
+//  WorkerPool::~WorkerPool()
+//-----------------------------------------------------------------------------
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+    m_tasks.clear();
+  }
+
+  m_condition.notify_all();
+
+  for (std::thread& thread : m_threads) {
+    thread.join();
+  }
+}
+
+//=============================================================================
+//  void WorkerPool::submit()
+//-----------------------------------------------------------------------------
+void
+WorkerPool::submit(Task task)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+  }
+
+  if (m_threads.empty()) {
+    for (size_t i = 0; i < m_nThreads; ++i) {
+      m_threads.emplace_back(&WorkerPool::run, this);
+    }
+  }
+
+  m_condition.notify_one();
+}
+
+//=============================================================================
+//  void WorkerPool::run()
+//-----------------------------------------------------------------------------
+void
+WorkerPool::run()
+{
+  for (;;) {
+    Task task;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this] { return m_isStopping || !m_tasks.empty(); });
+
+      if (m_isStopping) {
+        return;
+      }
+
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+
+    task();
+  }
+}
+
+} // namespace impl
+} // namespace sfmlConsole
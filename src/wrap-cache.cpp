@@ -0,0 +1,150 @@
+/*
+===============================================================================
+  SFML-Console: Developer Console Library for SFML
+  Copyright (C) 2016  Vince Lehman (vlehman1@gmail.com)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+  A copy of the full license can be found in LICENSE.txt.
+===============================================================================
+*/
+
+#include "wrap-cache.hpp"
+
+namespace sfmlConsole {
+namespace impl {
+
+//=============================================================================
+//  WrapCache::WrapCache()
+//-----------------------------------------------------------------------------
+WrapCache::WrapCache(const sf::Font& font, unsigned int characterSize, size_t nSlots)
+  : m_advances(font, characterSize)
+  , m_width(0)
+  , m_generation(1)
+  , m_slots(nSlots, Slot{ 0, 0, Breaks() })
+{
+}
+
+//=============================================================================
+//  void WrapCache::setWidth()
+//-----------------------------------------------------------------------------
+void
+WrapCache::setWidth(float width)
+{
+  if (width == m_width) {
+    return;
+  }
+
+  m_width = width;
+  m_generation++;
+}
+
+//=============================================================================
+//  void WrapCache::setMonospace()
+//-----------------------------------------------------------------------------
+void
+WrapCache::setMonospace(bool isMonospace)
+{
+  if (isMonospace == m_advances.isMonospace()) {
+    return;
+  }
+
+  m_advances.setMonospace(isMonospace);
+  m_generation++;
+}
+
+//=============================================================================
+//  void WrapCache::forget()
+//-----------------------------------------------------------------------------
+void
+WrapCache::forget(size_t lineNumber)
+{
+  Slot& slot = m_slots[lineNumber % m_slots.size()];
+
+  if (slot.lineNumber == lineNumber) {
+    slot.generation = 0;
+  }
+}
+
+//=============================================================================
+//  const Breaks& WrapCache::getBreaks()
+//-----------------------------------------------------------------------------
+const WrapCache::Breaks&
+WrapCache::getBreaks(size_t lineNumber, std::string_view text)
+{
+  Slot& slot = m_slots[lineNumber % m_slots.size()];
+
+  if (slot.generation != m_generation || slot.lineNumber != lineNumber) {
+    slot.lineNumber = lineNumber;
+    slot.generation = m_generation;
+    wrap(text, slot.breaks);
+  }
+
+  return slot.breaks;
+}
+
+//=============================================================================
+//  void WrapCache::wrap()
+//-----------------------------------------------------------------------------
+void
+WrapCache::wrap(std::string_view text, Breaks& breaks)
+{
+  breaks.clear();
+
+  // Too narrow for anything, leave lines whole
+  if (m_width <= 0) {
+    return;
+  }
+
+  size_t rowBegin = 0;
+
+  // Where the row could break, just after its last blank
+  size_t lastBlankEnd = 0;
+
+  float x = 0;
+  uint32_t previous = 0;
+
+  for (size_t i = 0; i < text.size(); ++i) {
+    uint32_t c = static_cast<unsigned char>(text[i]);
+    float advance = m_advances.get(previous, c);
+
+    if (x + advance > m_width && i > rowBegin && !isBlank(text[i])) {
+      rowBegin = lastBlankEnd > rowBegin ? lastBlankEnd : i;
+      breaks.push_back(static_cast<uint32_t>(rowBegin));
+
+      // Carry the start of the word over to the new row
+      x = 0;
+      previous = 0;
+
+      for (size_t j = rowBegin; j < i; ++j) {
+        uint32_t carried = static_cast<unsigned char>(text[j]);
+        x += m_advances.get(previous, carried);
+        previous = carried;
+      }
+
+      advance = m_advances.get(previous, c);
+    }
+
+    x += advance;
+    previous = c;
+
+    if (isBlank(text[i])) {
+      lastBlankEnd = i + 1;
+    }
+  }
+}
+
+} // namespace impl
+} // namespace sfmlConsole